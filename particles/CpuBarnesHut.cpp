@@ -0,0 +1,224 @@
+#include "CpuBarnesHut.h"
+#include "Morton.h"
+#include "SimulationConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const std::uint32_t EMPTY_LEAF_KEY = 0xffffffffu; // of barnes_hut.glsl
+	const std::uint32_t LEAF_BIT = 0x80000000u;
+	// findMSB of GLSL for a nonzero _v
+	int highestBit(std::uint32_t _v)
+	{
+		int bit = 0;
+		for (int shift = 16; shift > 0; shift /= 2)
+			if (_v >> shift)
+			{
+				_v >>= shift;
+				bit += shift;
+			}
+		return bit;
+	}
+}
+
+CpuBarnesHut::CpuBarnesHut(std::size_t _capacity, const fhl::Vec3f & _domainMin, float _domainSize, float _openingAngle, fhl::ThreadPool & _pool) :
+	m_pool(_pool),
+	m_domainMin{_domainMin},
+	m_domainScale{MORTON_CELLS / _domainSize},
+	m_openingAngle{_openingAngle},
+	m_sort(_capacity, _pool),
+	m_nodes(_capacity),
+	m_parents(2u * _capacity),
+	m_visits{new std::atomic<std::uint32_t>[_capacity]}
+{
+}
+
+std::uint32_t CpuBarnesHut::mortonOf(float _x, float _y, float _z) const
+{
+	// same as mortonOf() of barnes_hut.glsl
+	return getMortonCode((_x - m_domainMin.x()) * m_domainScale, (_y - m_domainMin.y()) * m_domainScale, (_z - m_domainMin.z()) * m_domainScale);
+}
+
+int CpuBarnesHut::commonPrefix(int _i, int _j, int _leafCount) const
+{
+	if (_j < 0 || _j >= _leafCount)
+		return -1;
+	const std::uint32_t a = m_sort.getKeys()[_i], b = m_sort.getKeys()[_j];
+	return a == b ? 32 + 31 - highestBit(std::uint32_t(_i ^ _j)) : 31 - highestBit(a ^ b);
+}
+
+void CpuBarnesHut::link(int _i, int _leafCount)
+{
+	// as bh_tree.comp
+	const int d = commonPrefix(_i, _i + 1, _leafCount) - commonPrefix(_i, _i - 1, _leafCount) >= 0 ? 1 : -1;
+	const int minPrefix = commonPrefix(_i, _i - d, _leafCount);
+	int maxLength = 2;
+	while (commonPrefix(_i, _i + maxLength * d, _leafCount) > minPrefix)
+		maxLength *= 2;
+	int length = 0;
+	for (int step = maxLength / 2; step >= 1; step /= 2)
+		if (commonPrefix(_i, _i + (length + step) * d, _leafCount) > minPrefix)
+			length += step;
+	const int j = _i + length * d;
+
+	const int nodePrefix = commonPrefix(_i, j, _leafCount);
+	int split = 0;
+	int step = length;
+	do
+	{
+		step = (step + 1) / 2;
+		if (commonPrefix(_i, _i + (split + step) * d, _leafCount) > nodePrefix)
+			split += step;
+	} while (step > 1);
+	const int gamma = _i + split * d + std::min(d, 0);
+
+	Node & node = m_nodes[_i];
+	node.children[0] = std::min(_i, j) == gamma ? std::uint32_t(gamma) | LEAF_BIT : std::uint32_t(gamma);
+	node.children[1] = std::max(_i, j) == gamma + 1 ? std::uint32_t(gamma + 1) | LEAF_BIT : std::uint32_t(gamma + 1);
+	for (std::uint32_t child : node.children)
+		m_parents[child & LEAF_BIT ? _leafCount - 1u + (child & ~LEAF_BIT) : child] = std::uint32_t(_i);
+}
+
+void CpuBarnesHut::summarize(std::uint32_t _leaf, std::uint32_t _leafCount, const ParticleStreams & _streams)
+{
+	// as bh_summarize.comp, the second thread to reach a node sums it
+	std::uint32_t idx = m_parents[_leafCount - 1u + _leaf];
+	for (;;)
+	{
+		if (m_visits[idx].fetch_add(1u, std::memory_order_acq_rel) == 0u)
+			return;
+		Node & node = m_nodes[idx];
+		float center[2][3], mass[2], boxMin[2][3], boxMax[2][3];
+		for (int c = 0; c < 2; ++c)
+		{
+			const std::uint32_t child = node.children[c];
+			if (!(child & LEAF_BIT))
+			{
+				const Node & childNode = m_nodes[child];
+				mass[c] = childNode.mass;
+				for (int a = 0; a < 3; ++a)
+				{
+					center[c][a] = childNode.centerOfMass[a];
+					boxMin[c][a] = childNode.boxMin[a];
+					boxMax[c][a] = childNode.boxMax[a];
+				}
+			}
+			else if (m_sort.getKeys()[child & ~LEAF_BIT] == EMPTY_LEAF_KEY)
+			{
+				mass[c] = 0.f;
+				for (int a = 0; a < 3; ++a)
+				{
+					center[c][a] = 0.f;
+					boxMin[c][a] = 1e30f;
+					boxMax[c][a] = -1e30f;
+				}
+			}
+			else
+			{
+				const std::uint32_t particle = m_sort.getValues()[child & ~LEAF_BIT];
+				const float pos[3] = { _streams.px[particle], _streams.py[particle], _streams.pz[particle] };
+				mass[c] = 1.f;
+				for (int a = 0; a < 3; ++a)
+					center[c][a] = boxMin[c][a] = boxMax[c][a] = pos[a];
+			}
+		}
+		node.mass = mass[0] + mass[1];
+		for (int a = 0; a < 3; ++a)
+		{
+			node.centerOfMass[a] = node.mass > 0.f ? (center[0][a] * mass[0] + center[1][a] * mass[1]) / node.mass : 0.f;
+			node.boxMin[a] = std::min(boxMin[0][a], boxMin[1][a]);
+			node.boxMax[a] = std::max(boxMax[0][a], boxMax[1][a]);
+		}
+		if (idx == 0u)
+			return;
+		idx = m_parents[idx];
+	}
+}
+
+void CpuBarnesHut::apply(const ParticleStreams & _streams, const ParticleSystemManager & _systems, float _dt)
+{
+	// leaves are all slots in use as in GlBarnesHut, the ones past the live particles are empty and sorted last
+	const std::size_t leafCount = _systems.getUsedCapacity();
+	if (leafCount < 2u)
+		return;
+	std::uint32_t * const keys = m_sort.getKeys();
+	std::uint32_t * const values = m_sort.getValues();
+	m_pool.parallelFor(leafCount, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			keys[i] = EMPTY_LEAF_KEY;
+			values[i] = std::uint32_t(i);
+			m_visits[i].store(0u, std::memory_order_relaxed);
+		}
+	});
+	m_pool.parallelFor(_systems.getLiveCount(), ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem &, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			for (std::size_t i = _rangeBegin; i < _rangeEnd; ++i)
+				keys[i] = mortonOf(_streams.px[i], _streams.py[i], _streams.pz[i]);
+		});
+	});
+
+	m_sort.sort(leafCount, 32u);
+
+	m_pool.parallelFor(leafCount - 1u, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t i = _begin; i < _end; ++i)
+			link(int(i), int(leafCount));
+	});
+	m_pool.parallelFor(leafCount, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t i = _begin; i < _end; ++i)
+			summarize(std::uint32_t(i), std::uint32_t(leafCount), _streams);
+	});
+
+	// as gravity.comp
+	const float openingAngle2 = m_openingAngle * m_openingAngle;
+	const float softening2 = constants::GRAVITY_SOFTENING * constants::GRAVITY_SOFTENING;
+	m_pool.parallelFor(_systems.getLiveCount(), ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem &, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			for (std::size_t i = _rangeBegin; i < _rangeEnd; ++i)
+			{
+				const float px = _streams.px[i], py = _streams.py[i], pz = _streams.pz[i];
+				float ax = 0.f, ay = 0.f, az = 0.f;
+				const auto pull = [&](float _dx, float _dy, float _dz, float _mass) {
+					const float r2 = _dx * _dx + _dy * _dy + _dz * _dz + softening2;
+					const float scale = constants::GRAVITY_CONSTANT * _mass / (r2 * std::sqrt(r2));
+					ax += _dx * scale;
+					ay += _dy * scale;
+					az += _dz * scale;
+				};
+				std::uint32_t stack[64];
+				int top = 0;
+				stack[top++] = 0u;
+				while (top > 0)
+				{
+					const Node & node = m_nodes[stack[--top]];
+					if (node.mass == 0.f)
+						continue;
+					const float dx = node.centerOfMass[0] - px, dy = node.centerOfMass[1] - py, dz = node.centerOfMass[2] - pz;
+					const float size = std::max(node.boxMax[0] - node.boxMin[0], std::max(node.boxMax[1] - node.boxMin[1], node.boxMax[2] - node.boxMin[2]));
+					if (size * size < openingAngle2 * (dx * dx + dy * dy + dz * dz))
+					{
+						pull(dx, dy, dz, node.mass);
+						continue;
+					}
+					for (std::uint32_t child : { node.children[1], node.children[0] })
+					{
+						if (!(child & LEAF_BIT))
+						{
+							stack[top++] = child;
+							continue;
+						}
+						const std::uint32_t leaf = child & ~LEAF_BIT;
+						const std::uint32_t other = values[leaf];
+						if (keys[leaf] != EMPTY_LEAF_KEY && other != i)
+							pull(_streams.px[other] - px, _streams.py[other] - py, _streams.pz[other] - pz, 1.f);
+					}
+				}
+				_streams.vx[i] += ax * _dt;
+				_streams.vy[i] += ay * _dt;
+				_streams.vz[i] += az * _dt;
+			}
+		});
+	});
+}
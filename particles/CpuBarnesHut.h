@@ -0,0 +1,60 @@
+#ifndef CPU_BARNES_HUT_H
+#define CPU_BARNES_HUT_H
+
+#include "CpuGravitySolver.h"
+#include "CpuRadixSort.h"
+#include "ParticleStorage.h"
+#include "ParticleSystemManager.h"
+#include "maths/vectors.h"
+#include "utility/ThreadPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * CPU version of GlBarnesHut on a thread pool, building the same binary radix tree over Morton codes as barnes_hut.glsl:
+ * a CpuRadixSort of the live particles by code, the internal nodes linked in parallel and summed bottom-up,
+ * then a traversal per particle visiting nodes in the same order as gravity.comp.
+ */
+class CpuBarnesHut : public CpuGravitySolver
+{
+public:
+	enum { ChunkSize = CpuRadixSort::ChunkSize };
+
+	CpuBarnesHut(std::size_t _capacity, const fhl::Vec3f & _domainMin, float _domainSize, float _openingAngle, fhl::ThreadPool & _pool);
+
+	CpuBarnesHut(const CpuBarnesHut &) = delete;
+	CpuBarnesHut & operator=(const CpuBarnesHut &) = delete;
+
+	/* rebuilds the tree from the live particles of _systems, then walks it for every one of them */
+	void apply(const ParticleStreams & _streams, const ParticleSystemManager & _systems, float _dt) override;
+
+private:
+	struct Node
+	{
+		float centerOfMass[3];
+		float mass;
+		float boxMin[3];
+		float boxMax[3];
+		std::uint32_t children[2]; // leaves with LEAF_BIT of barnes_hut.glsl
+	};
+
+	std::uint32_t mortonOf(float _x, float _y, float _z) const;
+	int commonPrefix(int _i, int _j, int _leafCount) const;
+	void link(int _i, int _leafCount);
+	void summarize(std::uint32_t _leaf, std::uint32_t _leafCount, const ParticleStreams & _streams);
+
+	fhl::ThreadPool & m_pool;
+	fhl::Vec3f m_domainMin;
+	float m_domainScale;
+	float m_openingAngle;
+	CpuRadixSort m_sort;
+	std::vector<Node> m_nodes;
+	std::vector<std::uint32_t> m_parents; // of internal node i at i, of leaf i at leafCount - 1 + i
+	std::unique_ptr<std::atomic<std::uint32_t>[]> m_visits;
+};
+
+#endif
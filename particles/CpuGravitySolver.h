@@ -0,0 +1,17 @@
+#ifndef CPU_GRAVITY_SOLVER_H
+#define CPU_GRAVITY_SOLVER_H
+
+#include "ParticleStorage.h"
+#include "ParticleSystemManager.h"
+
+/* Common interface of the CPU counterparts of GlGravitySolver, run by CpuParticleSimulator before every step */
+class CpuGravitySolver
+{
+public:
+	virtual ~CpuGravitySolver() = default;
+
+	/* adds the accelerations times _dt to the velocities of the live particles of _systems */
+	virtual void apply(const ParticleStreams & _streams, const ParticleSystemManager & _systems, float _dt) = 0;
+};
+
+#endif
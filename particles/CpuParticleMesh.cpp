@@ -0,0 +1,169 @@
+#include "CpuParticleMesh.h"
+#include "SimulationConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const float PI = 3.14159265f;
+	const std::size_t CHUNK_SIZE = 1u << 14; // particles or grid cells per pool chunk
+
+	// the 8 grid points around a particle, in pm_deposit.comp order
+	float cornerWeight(const float * _frac, int _corner)
+	{
+		const float wx = _corner & 1 ? _frac[0] : 1.f - _frac[0];
+		const float wy = _corner & 2 ? _frac[1] : 1.f - _frac[1];
+		const float wz = _corner & 4 ? _frac[2] : 1.f - _frac[2];
+		return wx * wy * wz;
+	}
+}
+
+CpuParticleMesh::CpuParticleMesh(const fhl::Vec3f & _domainMin, float _domainSize, unsigned _gridSize, fhl::ThreadPool & _pool) :
+	m_pool(_pool),
+	m_domainMin{_domainMin},
+	m_cellsPerUnit{_gridSize / _domainSize},
+	m_gridSize{_gridSize}
+{
+	const std::size_t cells = m_gridSize * m_gridSize * m_gridSize;
+	m_density.reset(new std::atomic<std::uint32_t>[cells]);
+	m_field.resize(cells);
+	m_twiddles.resize(m_gridSize / 2u);
+	for (std::size_t k = 0u; k < m_twiddles.size(); ++k)
+	{
+		const double angle = 2. * 3.14159265358979323846 * double(k) / double(m_gridSize);
+		m_twiddles[k] = Complex{float(std::cos(angle)), float(std::sin(angle))};
+	}
+	m_bitReversed.resize(m_gridSize);
+	for (std::size_t i = 1u; i < m_gridSize; ++i)
+		m_bitReversed[i] = m_bitReversed[i / 2u] / 2u + (i & 1u ? m_gridSize / 2u : 0u);
+}
+
+std::size_t CpuParticleMesh::gridIndex(int _x, int _y, int _z) const
+{
+	const int mask = int(m_gridSize) - 1;
+	return std::size_t(_x & mask) + m_gridSize * (std::size_t(_y & mask) + m_gridSize * std::size_t(_z & mask));
+}
+
+bool CpuParticleMesh::cloudInCell(float _x, float _y, float _z, int * _base, float * _frac) const
+{
+	// as cloudInCell() of particle_mesh.glsl
+	const float u[3] = { (_x - m_domainMin.x()) * m_cellsPerUnit - .5f, (_y - m_domainMin.y()) * m_cellsPerUnit - .5f, (_z - m_domainMin.z()) * m_cellsPerUnit - .5f };
+	for (int a = 0; a < 3; ++a)
+	{
+		if (!(std::fabs(u[a]) < 1e9f))
+			return false;
+		const float lower = std::floor(u[a]);
+		_base[a] = int(lower);
+		_frac[a] = u[a] - lower;
+	}
+	return true;
+}
+
+void CpuParticleMesh::transform(int _axis, float _sign, bool _loadDensity)
+{
+	// as pm_fft.comp, a line at a time
+	const std::size_t n = m_gridSize;
+	const std::size_t stride = _axis == 0 ? 1u : _axis == 1 ? n : n * n;
+	m_pool.parallelFor(n * n, std::max<std::size_t>(CHUNK_SIZE / n, 1u), [&](std::size_t _begin, std::size_t _end) {
+		std::vector<Complex> line(n);
+		for (std::size_t l = _begin; l < _end; ++l)
+		{
+			const std::size_t a = l % n, b = l / n;
+			const std::size_t first = _axis == 0 ? n * (a + n * b) : _axis == 1 ? a + n * n * b : a + n * b;
+			for (std::size_t i = 0u; i < n; ++i)
+				line[m_bitReversed[i]] = _loadDensity ? Complex{float(m_density[first + i * stride].load(std::memory_order_relaxed)), 0.f} : m_field[first + i * stride];
+			for (std::size_t half = 1u; half < n; half *= 2u)
+				for (std::size_t t = 0u; t < n / 2u; ++t)
+				{
+					const std::size_t k = t & (half - 1u);
+					const std::size_t i = (t - k) * 2u + k, j = i + half;
+					const Complex & twiddle = m_twiddles[k * (n / (2u * half))];
+					const Complex w{twiddle.re, _sign * twiddle.im};
+					const Complex odd{line[j].re * w.re - line[j].im * w.im, line[j].re * w.im + line[j].im * w.re};
+					const Complex even = line[i];
+					line[i] = Complex{even.re + odd.re, even.im + odd.im};
+					line[j] = Complex{even.re - odd.re, even.im - odd.im};
+				}
+			for (std::size_t i = 0u; i < n; ++i)
+				m_field[first + i * stride] = line[i];
+		}
+	});
+}
+
+void CpuParticleMesh::solve()
+{
+	// as pm_solve.comp
+	const std::size_t n = m_gridSize;
+	const float scale = -PI * constants::GRAVITY_CONSTANT * m_cellsPerUnit / (constants::PM_MASS_SCALE * float(n) * float(n) * float(n));
+	m_pool.parallelFor(n * n, std::max<std::size_t>(CHUNK_SIZE / n, 1u), [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t l = _begin; l < _end; ++l)
+		{
+			const float sy = std::sin(PI * float(l % n) / float(n)), sz = std::sin(PI * float(l / n) / float(n));
+			for (std::size_t x = 0u; x < n; ++x)
+			{
+				const float sx = std::sin(PI * float(x) / float(n));
+				const float s = sx * sx + sy * sy + sz * sz;
+				Complex & value = m_field[x + n * l];
+				value = s > 0.f ? Complex{value.re * (scale / s), value.im * (scale / s)} : Complex{0.f, 0.f};
+			}
+		}
+	});
+}
+
+void CpuParticleMesh::apply(const ParticleStreams & _streams, const ParticleSystemManager & _systems, float _dt)
+{
+	const std::size_t cells = m_gridSize * m_gridSize * m_gridSize;
+	m_pool.parallelFor(cells, CHUNK_SIZE, [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t i = _begin; i < _end; ++i)
+			m_density[i].store(0u, std::memory_order_relaxed);
+	});
+	// integer sums don't depend on the order of the adds
+	m_pool.parallelFor(_systems.getLiveCount(), CHUNK_SIZE, [&](std::size_t _begin, std::size_t _end) {
+		_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem &, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			for (std::size_t i = _rangeBegin; i < _rangeEnd; ++i)
+			{
+				int base[3];
+				float frac[3];
+				if (!cloudInCell(_streams.px[i], _streams.py[i], _streams.pz[i], base, frac))
+					continue;
+				for (int c = 0; c < 8; ++c)
+					m_density[gridIndex(base[0] + (c & 1), base[1] + (c >> 1 & 1), base[2] + (c >> 2))].fetch_add(
+						std::uint32_t(cornerWeight(frac, c) * constants::PM_MASS_SCALE + .5f), std::memory_order_relaxed);
+			}
+		});
+	});
+
+	for (int axis = 0; axis < 3; ++axis)
+		transform(axis, -1.f, axis == 0);
+	solve();
+	for (int axis = 0; axis < 3; ++axis)
+		transform(axis, 1.f, false);
+
+	// as pm_force.comp
+	const float forceScale = .5f * m_cellsPerUnit * _dt;
+	m_pool.parallelFor(_systems.getLiveCount(), CHUNK_SIZE, [&](std::size_t _begin, std::size_t _end) {
+		_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem &, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			const auto potential = [&](int _x, int _y, int _z) { return m_field[gridIndex(_x, _y, _z)].re; };
+			for (std::size_t i = _rangeBegin; i < _rangeEnd; ++i)
+			{
+				int base[3];
+				float frac[3];
+				if (!cloudInCell(_streams.px[i], _streams.py[i], _streams.pz[i], base, frac))
+					continue;
+				float ax = 0.f, ay = 0.f, az = 0.f;
+				for (int c = 0; c < 8; ++c)
+				{
+					const int x = base[0] + (c & 1), y = base[1] + (c >> 1 & 1), z = base[2] + (c >> 2);
+					const float w = cornerWeight(frac, c);
+					ax -= (potential(x + 1, y, z) - potential(x - 1, y, z)) * w;
+					ay -= (potential(x, y + 1, z) - potential(x, y - 1, z)) * w;
+					az -= (potential(x, y, z + 1) - potential(x, y, z - 1)) * w;
+				}
+				_streams.vx[i] += ax * forceScale;
+				_streams.vy[i] += ay * forceScale;
+				_streams.vz[i] += az * forceScale;
+			}
+		});
+	});
+}
@@ -0,0 +1,51 @@
+#ifndef CPU_PARTICLE_MESH_H
+#define CPU_PARTICLE_MESH_H
+
+#include "CpuGravitySolver.h"
+#include "maths/vectors.h"
+#include "utility/ThreadPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * CPU version of GlParticleMesh on a thread pool, on the same grid as particle_mesh.glsl: the fixed point deposit with atomic adds,
+ * the same radix-2 FFT run over independent grid lines in parallel, the Poisson solve and the interpolated potential gradient.
+ */
+class CpuParticleMesh : public CpuGravitySolver
+{
+public:
+	CpuParticleMesh(const fhl::Vec3f & _domainMin, float _domainSize, unsigned _gridSize, fhl::ThreadPool & _pool);
+
+	CpuParticleMesh(const CpuParticleMesh &) = delete;
+	CpuParticleMesh & operator=(const CpuParticleMesh &) = delete;
+
+	void apply(const ParticleStreams & _streams, const ParticleSystemManager & _systems, float _dt) override;
+
+private:
+	struct Complex
+	{
+		float re;
+		float im;
+	};
+
+	std::size_t gridIndex(int _x, int _y, int _z) const;
+	bool cloudInCell(float _x, float _y, float _z, int * _base, float * _frac) const;
+	/* transforms the lines along _axis in place, _sign -1 forward and 1 inverse (unnormalized) */
+	void transform(int _axis, float _sign, bool _loadDensity);
+	void solve();
+
+	fhl::ThreadPool & m_pool;
+	fhl::Vec3f m_domainMin;
+	float m_cellsPerUnit;
+	std::size_t m_gridSize;
+	std::unique_ptr<std::atomic<std::uint32_t>[]> m_density;
+	std::vector<Complex> m_field;
+	std::vector<Complex> m_twiddles; // exp(2 pi i k / gridSize) for k < gridSize / 2
+	std::vector<std::size_t> m_bitReversed;
+};
+
+#endif
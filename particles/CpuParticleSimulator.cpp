@@ -0,0 +1,213 @@
+#include "CpuParticleSimulator.h"
+#include "Morton.h"
+#include "SimulationConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+	const std::uint32_t UNORDERED_KEY = 0xffffffffu; // of compact.glsl
+}
+
+CpuParticleSimulator::CpuParticleSimulator(ParticleStorage _storage, ParticleSystemManager & _systems, fhl::ThreadPool & _pool, KernelIsa _isa) :
+	m_systems(_systems),
+	m_pool(_pool),
+	m_isa{_isa},
+	m_kernel{getUpdateKernel(_isa)},
+	m_storage{std::move(_storage)},
+	m_mortonScale{}
+{
+}
+
+void CpuParticleSimulator::update(const SimulationParams & _params)
+{
+	const ParticleStreams & streams = m_storage.getStreams();
+	if (m_hash)
+		interact(_params.dt);
+	if (m_gravity)
+		m_gravity->apply(streams, m_systems, _params.dt);
+	m_pool.parallelFor(m_systems.getLiveCount(), WorkgroupSize * ChunkWorkgroups, [&](std::size_t _begin, std::size_t _end) {
+		m_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem & _system, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			if (_params.forceFieldCount)
+				kernels::applyForceFields(streams, _params, _rangeBegin, _rangeEnd);
+			m_kernel(streams, makeUpdateParams(_params, _system.getAttractorScale()), _rangeBegin, _rangeEnd);
+		});
+	});
+}
+
+void CpuParticleSimulator::exportState(StateLayout _layout, void * _positions, void * _velocities) const
+{
+	m_pool.parallelFor(m_storage.size(), WorkgroupSize * ChunkWorkgroups, [&](std::size_t _begin, std::size_t _end) {
+		m_storage.storeState(_layout, _positions, _velocities, _begin, _end);
+	});
+}
+
+void CpuParticleSimulator::exportPositions(StateLayout _layout, void * _positions) const
+{
+	m_pool.parallelFor(m_storage.size(), WorkgroupSize * ChunkWorkgroups, [&](std::size_t _begin, std::size_t _end) {
+		m_storage.storePositions(_layout, _positions, _begin, _end);
+	});
+}
+
+void CpuParticleSimulator::compact(const fhl::Vec3f & _killCenter, float _killRadius)
+{
+	if (m_scratch.size() != m_storage.size())
+		m_scratch = ParticleStorage{m_storage.size()};
+	const ParticleStreams & src = m_storage.getStreams();
+	const ParticleStreams & dst = m_scratch.getStreams();
+	const float radiusSq = _killRadius * _killRadius;
+	// same test as survives() of compact.glsl, NaN positions are removed too
+	const auto survives = [&](std::size_t _idx) {
+		const float dx = src.px[_idx] - _killCenter.x(), dy = src.py[_idx] - _killCenter.y(), dz = src.pz[_idx] - _killCenter.z();
+		return dx * dx + dy * dy + dz * dz <= radiusSq;
+	};
+
+	const std::size_t grain = WorkgroupSize * ChunkWorkgroups;
+	if (m_orderSort)
+	{ // as GlParticleCompactor with Morton ordering, survivors are sorted by system index and then Morton code
+		unsigned systemBits = 0u;
+		while ((std::size_t(1u) << systemBits) < m_systems.getSystemCount())
+			++systemBits;
+		const unsigned mortonBits = std::min(30u, (31u - systemBits) / 3u * 3u);
+		const std::size_t used = m_systems.getUsedCapacity();
+		std::uint32_t * const keys = m_orderSort->getKeys();
+		std::uint32_t * const values = m_orderSort->getValues();
+		m_pool.parallelFor(used, CpuRadixSort::ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+			for (std::size_t i = _begin; i < _end; ++i)
+			{
+				keys[i] = UNORDERED_KEY;
+				values[i] = std::uint32_t(i);
+			}
+		});
+		for (std::size_t s = 0u; s < m_systems.getSystemCount(); ++s)
+		{
+			const std::size_t first = m_systems.getSystem(s).getFirst();
+			m_pool.parallelFor(m_systems.getSystem(s).getCount(), grain, [&](std::size_t _begin, std::size_t _end) {
+				for (std::size_t i = first + _begin; i < first + _end; ++i)
+					if (survives(i))
+						keys[i] = std::uint32_t(s) << mortonBits | getMortonCode((src.px[i] - m_mortonMin.x()) * m_mortonScale,
+							(src.py[i] - m_mortonMin.y()) * m_mortonScale, (src.pz[i] - m_mortonMin.z()) * m_mortonScale) >> (30u - mortonBits);
+			});
+		}
+		m_orderSort->sort(used, systemBits + mortonBits);
+		const std::uint32_t * const sortedKeys = keys;
+		for (std::size_t s = 0u; s < m_systems.getSystemCount(); ++s)
+		{
+			ParticleSystem & system = m_systems.getSystem(s);
+			const std::size_t first = system.getFirst();
+			const std::uint32_t * const begin = std::lower_bound(sortedKeys, sortedKeys + used, std::uint32_t(s) << mortonBits);
+			const std::uint32_t * const end = std::lower_bound(begin, sortedKeys + used, std::uint32_t(s + 1u) << mortonBits);
+			const std::size_t sortedBegin = std::size_t(begin - sortedKeys);
+			m_pool.parallelFor(std::size_t(end - begin), grain, [&](std::size_t _begin, std::size_t _end) {
+				for (std::size_t out = first + _begin; out < first + _end; ++out)
+				{
+					const std::uint32_t i = values[sortedBegin + out - first];
+					dst.px[out] = src.px[i];
+					dst.py[out] = src.py[i];
+					dst.pz[out] = src.pz[i];
+					dst.vx[out] = src.vx[i];
+					dst.vy[out] = src.vy[i];
+					dst.vz[out] = src.vz[i];
+				}
+			});
+			system.setCount(std::size_t(end - begin));
+		}
+		std::swap(m_storage, m_scratch);
+		return;
+	}
+	for (std::size_t s = 0u; s < m_systems.getSystemCount(); ++s)
+	{
+		ParticleSystem & system = m_systems.getSystem(s);
+		const std::size_t first = system.getFirst();
+		// survivors per chunk, exclusively prefix summed into the chunks' first destinations
+		m_chunkSurvivors.assign((system.getCount() + grain - 1u) / grain, 0u);
+		m_pool.parallelFor(system.getCount(), grain, [&](std::size_t _begin, std::size_t _end) {
+			std::size_t survivors = 0u;
+			for (std::size_t i = first + _begin; i < first + _end; ++i)
+				survivors += survives(i) ? 1u : 0u;
+			m_chunkSurvivors[_begin / grain] = survivors;
+		});
+		std::size_t total = 0u;
+		for (std::size_t & chunk : m_chunkSurvivors)
+		{
+			const std::size_t survivors = chunk;
+			chunk = total;
+			total += survivors;
+		}
+		m_pool.parallelFor(system.getCount(), grain, [&](std::size_t _begin, std::size_t _end) {
+			std::size_t out = first + m_chunkSurvivors[_begin / grain];
+			for (std::size_t i = first + _begin; i < first + _end; ++i)
+				if (survives(i))
+				{
+					dst.px[out] = src.px[i];
+					dst.py[out] = src.py[i];
+					dst.pz[out] = src.pz[i];
+					dst.vx[out] = src.vx[i];
+					dst.vy[out] = src.vy[i];
+					dst.vz[out] = src.vz[i];
+					++out;
+				}
+		});
+		system.setCount(total);
+	}
+	std::swap(m_storage, m_scratch);
+}
+
+void CpuParticleSimulator::setMortonOrder(const fhl::Vec3f & _min, float _size)
+{
+	m_orderSort = std::make_unique<CpuRadixSort>(m_storage.size(), m_pool);
+	m_mortonMin = _min;
+	m_mortonScale = MORTON_CELLS / _size;
+}
+
+void CpuParticleSimulator::setInteractionRadius(float _radius)
+{
+	m_hash.reset();
+	if (_radius > 0.f)
+		m_hash = std::make_unique<CpuSpatialHash>(m_storage.size(), _radius, m_pool);
+}
+
+void CpuParticleSimulator::interact(float _dt)
+{
+	const ParticleStreams & s = m_storage.getStreams();
+	m_hash->build(s, m_systems);
+	const float radius = m_hash->getCellSize();
+	// same order of operations as interact.comp
+	m_pool.parallelFor(m_systems.getLiveCount(), WorkgroupSize * ChunkWorkgroups, [&](std::size_t _begin, std::size_t _end) {
+		m_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem &, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			for (std::size_t i = _rangeBegin; i < _rangeEnd; ++i)
+			{
+				const float px = s.px[i], py = s.py[i], pz = s.pz[i];
+				const int cx = m_hash->getCellCoord(px), cy = m_hash->getCellCoord(py), cz = m_hash->getCellCoord(pz);
+				float ax = 0.f, ay = 0.f, az = 0.f;
+				int neighbours = 0;
+				for (int z = -1; z <= 1; ++z)
+					for (int y = -1; y <= 1; ++y)
+						for (int x = -1; x <= 1; ++x)
+						{
+							const CpuSpatialHash::CellRange & range = m_hash->getCell(CpuSpatialHash::getKey(cx + x, cy + y, cz + z));
+							for (std::uint32_t j = range.begin; j < range.end && neighbours < constants::INTERACTION_MAX_NEIGHBOURS; ++j)
+							{
+								const std::uint32_t other = m_hash->getParticle(j);
+								const float dx = px - s.px[other], dy = py - s.py[other], dz = pz - s.pz[other];
+								const float r2 = dx * dx + dy * dy + dz * dz;
+								if (r2 == 0.f || r2 >= radius * radius)
+									continue;
+								const float r = std::sqrt(r2);
+								const float q = r / radius;
+								const float scale = (constants::INTERACTION_REPULSION * (1.f - q) - constants::INTERACTION_COHESION * q) * (1.f - q) / r;
+								ax += dx * scale;
+								ay += dy * scale;
+								az += dz * scale;
+								++neighbours;
+							}
+						}
+				s.vx[i] += ax * _dt;
+				s.vy[i] += ay * _dt;
+				s.vz[i] += az * _dt;
+			}
+		});
+	});
+}
@@ -0,0 +1,66 @@
+#ifndef CPU_PARTICLE_SIMULATOR_H
+#define CPU_PARTICLE_SIMULATOR_H
+
+#include "CpuGravitySolver.h"
+#include "CpuRadixSort.h"
+#include "CpuSpatialHash.h"
+#include "ParticleSimulator.h"
+#include "ParticleKernels.h"
+#include "ParticleStorage.h"
+#include "ParticleSystemManager.h"
+#include "utility/ThreadPool.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* Reference CPU implementation of simulate.comp (with force fields as force_fields.glsl) over the live particles of all systems of _systems, preceded by interact.comp
+   if interactions are enabled and by a gravity solver if one is set, and of the GlParticleCompactor compaction */
+class CpuParticleSimulator : public ParticleSimulator
+{
+public:
+	/* simulate.comp workgroups (local_size_x = 64) per pool chunk; 16 * 64 particles * 24 bytes fit in L1 */
+	enum { WorkgroupSize = 64, ChunkWorkgroups = 16 };
+
+	CpuParticleSimulator(ParticleStorage _storage, ParticleSystemManager & _systems, fhl::ThreadPool & _pool, KernelIsa _isa);
+
+	void update(const SimulationParams & _params) override;
+	std::size_t getParticleCount() const override { return m_storage.size(); }
+
+	KernelIsa getKernelIsa() const { return m_isa; }
+	const ParticleStorage & getStorage() const { return m_storage; }
+
+	/* writes the state in the layout of the GL buffers, see ParticleStorage::storeState */
+	void exportState(StateLayout _layout, void * _positions, void * _velocities) const;
+	void exportPositions(StateLayout _layout, void * _positions) const;
+
+	/* packs the particles of every system within _killRadius of _killCenter to the start of its range, keeping their order
+	   or in Morton order, and sets the system counts to them; the counts take effect with the next ParticleSystemManager::upload() */
+	void compact(const fhl::Vec3f & _killCenter, float _killRadius);
+	/* sorts the survivors of later compactions as GlParticleCompactor::setMortonOrder */
+	void setMortonOrder(const fhl::Vec3f & _min, float _size);
+
+	/* particles closer than _radius repel and attract each other (see SimulationConstants.h), 0 disables it */
+	void setInteractionRadius(float _radius);
+	/* gravity between all live particles, nullptr disables it */
+	void setGravity(std::unique_ptr<CpuGravitySolver> _gravity) { m_gravity = std::move(_gravity); }
+
+private:
+	void interact(float _dt);
+
+	ParticleSystemManager & m_systems;
+	fhl::ThreadPool & m_pool;
+	KernelIsa m_isa;
+	UpdateKernel m_kernel;
+	ParticleStorage m_storage;
+	ParticleStorage m_scratch; // compaction target, swapped with m_storage
+	std::vector<std::size_t> m_chunkSurvivors;
+	std::unique_ptr<CpuRadixSort> m_orderSort; // when ordering, by system index and Morton code as compact_keys.comp
+	fhl::Vec3f m_mortonMin;
+	float m_mortonScale;
+	std::unique_ptr<CpuSpatialHash> m_hash;
+	std::unique_ptr<CpuGravitySolver> m_gravity;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "CpuRadixSort.h"
+
+#include <algorithm>
+
+namespace
+{
+	const std::uint32_t DIGITS = 1u << CpuRadixSort::DigitBits;
+}
+
+CpuRadixSort::CpuRadixSort(std::size_t _capacity, fhl::ThreadPool & _pool) :
+	m_pool(_pool)
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		m_keys[i].resize(_capacity);
+		m_values[i].resize(_capacity);
+	}
+	m_chunkOffsets.resize((_capacity + ChunkSize - 1u) / ChunkSize * DIGITS);
+}
+
+void CpuRadixSort::sort(std::size_t _count, unsigned _keyBits)
+{
+	// an even number of passes leaves the result in the first buffers
+	const std::size_t chunks = (_count + ChunkSize - 1u) / ChunkSize;
+	unsigned passes = (_keyBits + DigitBits - 1u) / DigitBits;
+	passes += passes & 1u;
+	for (unsigned pass = 0u; pass < passes; ++pass)
+	{
+		const std::vector<std::uint32_t> & keysIn = m_keys[pass & 1u], & valuesIn = m_values[pass & 1u];
+		std::vector<std::uint32_t> & keysOut = m_keys[~pass & 1u], & valuesOut = m_values[~pass & 1u];
+		const unsigned shift = pass * DigitBits;
+		const std::uint32_t mask = shift < 32u ? DIGITS - 1u : 0u; // passes past the key only copy
+		const unsigned digitShift = shift < 32u ? shift : 0u;
+		m_pool.parallelFor(_count, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+			std::uint32_t * const counts = &m_chunkOffsets[_begin / ChunkSize * DIGITS];
+			std::fill(counts, counts + DIGITS, 0u);
+			for (std::size_t i = _begin; i < _end; ++i)
+				++counts[(keysIn[i] >> digitShift) & mask];
+		});
+		// digit-major, so that every chunk's elements of a digit follow the ones of the chunks before it
+		std::uint32_t offset = 0u;
+		for (std::uint32_t digit = 0u; digit < DIGITS; ++digit)
+			for (std::size_t chunk = 0u; chunk < chunks; ++chunk)
+			{
+				std::uint32_t & entry = m_chunkOffsets[chunk * DIGITS + digit];
+				const std::uint32_t digitCount = entry;
+				entry = offset;
+				offset += digitCount;
+			}
+		m_pool.parallelFor(_count, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+			std::uint32_t * const offsets = &m_chunkOffsets[_begin / ChunkSize * DIGITS];
+			for (std::size_t i = _begin; i < _end; ++i)
+			{
+				const std::uint32_t destination = offsets[(keysIn[i] >> digitShift) & mask]++;
+				keysOut[destination] = keysIn[i];
+				valuesOut[destination] = valuesIn[i];
+			}
+		});
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef CPU_RADIX_SORT_H
+#define CPU_RADIX_SORT_H
+
+#include "utility/ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Stable LSD radix sort of up to _capacity uint32 key/value pairs on a thread pool, DigitBits per pass:
+ * digit counts per chunk, a serial exclusive scan over the chunks in digit-major order and a parallel scatter
+ * of every chunk to its destinations. CPU counterpart of GlRadixSort, O(n) per pass.
+ */
+class CpuRadixSort
+{
+public:
+	enum { DigitBits = 11, ChunkSize = 1 << 14 };
+
+	CpuRadixSort(std::size_t _capacity, fhl::ThreadPool & _pool);
+
+	CpuRadixSort(const CpuRadixSort &) = delete;
+	CpuRadixSort & operator=(const CpuRadixSort &) = delete;
+
+	/* _capacity keys and values, filled by the caller before sort() */
+	std::uint32_t * getKeys() { return m_keys[0].data(); }
+	std::uint32_t * getValues() { return m_values[0].data(); }
+	const std::uint32_t * getKeys() const { return m_keys[0].data(); }
+	const std::uint32_t * getValues() const { return m_values[0].data(); }
+
+	/* sorts the first _count pairs by the low _keyBits bits of the keys, keeping the order of equal keys;
+	   the sorted pairs are left in getKeys() and getValues() */
+	void sort(std::size_t _count, unsigned _keyBits);
+
+private:
+	fhl::ThreadPool & m_pool;
+	std::vector<std::uint32_t> m_keys[2];
+	std::vector<std::uint32_t> m_values[2];
+	std::vector<std::uint32_t> m_chunkOffsets; // digit counts of every chunk, then their first destinations
+};
+
+#endif
@@ -0,0 +1,64 @@
+#include "CpuSpatialHash.h"
+#include "SimulationConstants.h"
+
+#include <algorithm>
+
+namespace
+{
+	const std::uint32_t CELL_MASK = (1u << constants::HASH_CELL_BITS) - 1u;
+	const std::uint32_t CELL_COUNT = 1u << (3 * constants::HASH_CELL_BITS);
+	const std::uint32_t EMPTY_KEY = CELL_COUNT; // HASH_EMPTY_KEY of spatial_hash.glsl
+	const unsigned KEY_BITS = 3 * constants::HASH_CELL_BITS + 1;
+}
+
+CpuSpatialHash::CpuSpatialHash(std::size_t _capacity, float _cellSize, fhl::ThreadPool & _pool) :
+	m_cellSize{_cellSize},
+	m_pool(_pool),
+	m_sort(_capacity, _pool),
+	m_cells(CELL_COUNT)
+{
+}
+
+std::uint32_t CpuSpatialHash::getKey(int _x, int _y, int _z)
+{
+	return (std::uint32_t(_x) & CELL_MASK) | (std::uint32_t(_y) & CELL_MASK) << constants::HASH_CELL_BITS
+		| (std::uint32_t(_z) & CELL_MASK) << (2 * constants::HASH_CELL_BITS);
+}
+
+void CpuSpatialHash::build(const ParticleStreams & _streams, const ParticleSystemManager & _systems)
+{
+	const std::size_t count = _systems.getUsedCapacity();
+	std::uint32_t * const keys = m_sort.getKeys();
+	std::uint32_t * const values = m_sort.getValues();
+	m_pool.parallelFor(count, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			keys[i] = EMPTY_KEY;
+			values[i] = std::uint32_t(i);
+		}
+	});
+	m_pool.parallelFor(_systems.getLiveCount(), ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		_systems.forEachLiveRange(_begin, _end, [&](const ParticleSystem &, std::size_t _rangeBegin, std::size_t _rangeEnd) {
+			for (std::size_t i = _rangeBegin; i < _rangeEnd; ++i)
+				keys[i] = getKey(getCellCoord(_streams.px[i]), getCellCoord(_streams.py[i]), getCellCoord(_streams.pz[i]));
+		});
+	});
+
+	m_sort.sort(count, KEY_BITS);
+
+	m_pool.parallelFor(CELL_COUNT, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		std::fill(m_cells.begin() + _begin, m_cells.begin() + _end, CellRange{0u, 0u});
+	});
+	m_pool.parallelFor(count, ChunkSize, [&](std::size_t _begin, std::size_t _end) {
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			const std::uint32_t key = keys[i];
+			if (key == EMPTY_KEY)
+				break; // sorted last
+			if (i == 0u || keys[i - 1u] != key)
+				m_cells[key].begin = std::uint32_t(i);
+			if (i + 1u == count || keys[i + 1u] != key)
+				m_cells[key].end = std::uint32_t(i + 1u);
+		}
+	});
+}
@@ -0,0 +1,57 @@
+#ifndef CPU_SPATIAL_HASH_H
+#define CPU_SPATIAL_HASH_H
+
+#include "CpuRadixSort.h"
+#include "ParticleStorage.h"
+#include "ParticleSystemManager.h"
+#include "utility/ThreadPool.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * CPU version of GlSpatialHash on a thread pool, with the same cells and keys as spatial_hash.glsl: keys of the live particles,
+ * a CpuRadixSort of the particle indices by key and the range of every cell in the sorted indices. Both sorts keep the index order within a cell,
+ * so neighbours are visited in the same order as by interact.comp.
+ */
+class CpuSpatialHash
+{
+public:
+	enum { ChunkSize = CpuRadixSort::ChunkSize };
+
+	struct CellRange
+	{
+		std::uint32_t begin;
+		std::uint32_t end;
+	};
+
+	CpuSpatialHash(std::size_t _capacity, float _cellSize, fhl::ThreadPool & _pool);
+
+	CpuSpatialHash(const CpuSpatialHash &) = delete;
+	CpuSpatialHash & operator=(const CpuSpatialHash &) = delete;
+
+	void build(const ParticleStreams & _streams, const ParticleSystemManager & _systems);
+
+	float getCellSize() const { return m_cellSize; }
+	/* cell of a position along one axis, clamped so that far or non-finite positions still give one */
+	int getCellCoord(float _position) const
+	{
+		const float cell = std::floor(_position / m_cellSize);
+		return int(cell >= -1e9f ? (cell <= 1e9f ? cell : 1e9f) : -1e9f);
+	}
+	static std::uint32_t getKey(int _x, int _y, int _z);
+
+	/* sorted particle indices of the cells sharing _key */
+	const CellRange & getCell(std::uint32_t _key) const { return m_cells[_key]; }
+	std::uint32_t getParticle(std::uint32_t _sortedIdx) const { return m_sort.getValues()[_sortedIdx]; }
+
+private:
+	float m_cellSize;
+	fhl::ThreadPool & m_pool;
+	CpuRadixSort m_sort;
+	std::vector<CellRange> m_cells;
+};
+
+#endif
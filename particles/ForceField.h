@@ -0,0 +1,27 @@
+#ifndef FORCE_FIELD_H
+#define FORCE_FIELD_H
+
+#include "maths/vectors.h"
+
+/*
+ * Force primitive applied to all particles every simulation step (see force_fields.glsl), before damping.
+ * With r the offset of a particle from position and falloff 1 / (1 + d^2 / radius^2) at distance d, the acceleration is:
+ * Point - strength * falloff towards position (d = |r|), negative strength repels;
+ * Vortex - strength * falloff around the axis through position along direction (d from the axis), counterclockwise seen from the axis' tip;
+ * Wind - strength along direction everywhere;
+ * Turbulence - divergence-free strength * (sin(q.y) cos(q.z), sin(q.z) cos(q.x), sin(q.x) cos(q.y)), q = r / radius + phase.
+ * direction has to be of unit length and radius positive for all but Wind.
+ */
+struct ForceField
+{
+	enum class Type { Point, Vortex, Wind, Turbulence };
+
+	Type type;
+	fhl::Vec3f position;
+	fhl::Vec3f direction;
+	float strength;
+	float radius;
+	float phase = 0.f; // of Turbulence, advancing it animates the field
+};
+
+#endif
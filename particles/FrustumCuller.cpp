@@ -0,0 +1,89 @@
+#include "FrustumCuller.h"
+
+#include <cmath>
+
+namespace
+{
+	enum UniformBlockBinding { CullParamsBlock = 2 };
+
+	// std140 CullParams block of cull.comp
+	struct CullUniforms
+	{
+		fhl::Vec4f planes[6];
+		float radius;
+		GLuint verticesPerVisible;
+		float padding[2];
+	};
+	static_assert(sizeof(CullUniforms) == 112, "CullUniforms must match the std140 layout of CullParams");
+
+	// conservative bounding radius of the view-space quad emitted for a particle
+	const float PARTICLE_RADIUS = .5f;
+}
+
+FrustumCuller::FrustumCuller(GLuint _program, const ParticleSystemManager & _systems, UniformRing & _uniforms) :
+	m_program{_program},
+	m_systems(_systems),
+	m_commandBuffer{},
+	m_visibleBuffer{},
+	m_uniforms(_uniforms)
+{
+	glCreateBuffers(1, &m_commandBuffer);
+	glNamedBufferStorage(m_commandBuffer, sizeof(DrawArraysIndirectCommand), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	glCreateBuffers(1, &m_visibleBuffer);
+	glNamedBufferStorage(m_visibleBuffer, m_systems.getCapacity() * sizeof(GLuint), nullptr, 0);
+}
+
+FrustumCuller::~FrustumCuller()
+{
+	glDeleteBuffers(1, &m_commandBuffer);
+	glDeleteBuffers(1, &m_visibleBuffer);
+}
+
+void FrustumCuller::cull(const fhl::Mat4f & _viewProjection, GLuint _verticesPerParticle)
+{
+	CullUniforms uniforms;
+	extractFrustumPlanes(_viewProjection, uniforms.planes);
+	uniforms.radius = PARTICLE_RADIUS;
+	uniforms.verticesPerVisible = _verticesPerParticle;
+	uniforms.padding[0] = uniforms.padding[1] = 0.f;
+	m_uniforms.push(UniformBlockBinding::CullParamsBlock, uniforms);
+
+	const DrawArraysIndirectCommand reset{0u, 1u, 0u, 0u};
+	glNamedBufferSubData(m_commandBuffer, 0, sizeof(reset), &reset);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::DrawCommandBuffer, m_commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::VisibleIndexBuffer, m_visibleBuffer);
+
+	glUseProgram(m_program);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+}
+
+void FrustumCuller::draw(GLenum _mode) const
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+	glDrawArraysIndirect(_mode, nullptr);
+}
+
+void FrustumCuller::extractFrustumPlanes(const fhl::Mat4f & _viewProjection, fhl::Vec4f (&_planes)[6])
+{
+	// Gribb-Hartmann: clip-space -w <= x, y, z <= w expressed as planes in world space
+	const fhl::Vec4f r0 = _viewProjection.getRow(0), r1 = _viewProjection.getRow(1);
+	const fhl::Vec4f r2 = _viewProjection.getRow(2), r3 = _viewProjection.getRow(3);
+	_planes[0] = r3 + r0;
+	_planes[1] = r3 - r0;
+	_planes[2] = r3 + r1;
+	_planes[3] = r3 - r1;
+	_planes[4] = r3 + r2;
+	_planes[5] = r3 - r2;
+	for (fhl::Vec4f & p : _planes)
+	{
+		const float len = std::sqrt(p.x() * p.x() + p.y() * p.y() + p.z() * p.z());
+		if (len > 0.f)
+			p /= len;
+	}
+}
+
+UniformUsage FrustumCuller::getUniformUsage()
+{
+	return UniformUsage{1u, sizeof(CullUniforms)};
+}
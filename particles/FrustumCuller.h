@@ -0,0 +1,53 @@
+#ifndef FRUSTUM_CULLER_H
+#define FRUSTUM_CULLER_H
+
+#include "gl/flextGL.h"
+#include "maths/Mat4.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+#include <cstddef>
+
+/*
+ * Runs cull.comp over the live particles of all systems and compacts indices of the ones inside the view frustum
+ * into a buffer bound at SSBO binding 3, counting them in a glDrawArraysIndirect command.
+ */
+class FrustumCuller
+{
+public:
+	enum Bindings { DrawCommandBuffer = 2, VisibleIndexBuffer = 3 };
+
+	FrustumCuller(GLuint _program, const ParticleSystemManager & _systems, UniformRing & _uniforms);
+	~FrustumCuller();
+
+	FrustumCuller(const FrustumCuller &) = delete;
+	FrustumCuller & operator=(const FrustumCuller &) = delete;
+
+	/* _verticesPerParticle - vertices the draw emits for every visible particle (1 for points, 6 for pulled quads) */
+	void cull(const fhl::Mat4f & _viewProjection, GLuint _verticesPerParticle);
+	/* uniform blocks a cull() pushes */
+	static UniformUsage getUniformUsage();
+	void draw(GLenum _mode) const;
+
+	/* takes a relinked cull.comp program, the caller keeps ownership */
+	void setProgram(GLuint _program) { m_program = _program; }
+
+	static void extractFrustumPlanes(const fhl::Mat4f & _viewProjection, fhl::Vec4f (&_planes)[6]);
+
+private:
+	struct DrawArraysIndirectCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint first;
+		GLuint baseInstance;
+	};
+
+	GLuint m_program;
+	const ParticleSystemManager & m_systems;
+	GLuint m_commandBuffer;
+	GLuint m_visibleBuffer;
+	UniformRing & m_uniforms;
+};
+
+#endif
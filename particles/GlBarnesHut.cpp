@@ -0,0 +1,98 @@
+#include "GlBarnesHut.h"
+#include "Morton.h"
+
+namespace
+{
+	enum UniformBlockBinding { GravityParamsBlock = 6 };
+
+	// std140 GravityParams block of barnes_hut.glsl
+	struct GravityUniforms
+	{
+		float domainMin[3];
+		float domainScale;
+		float openingAngle2;
+		GLuint leafCount;
+		GLuint padding[2];
+	};
+
+	// std430 TreeNode struct of barnes_hut.glsl
+	struct TreeNode
+	{
+		float centerOfMass[4];
+		float boxMin[4];
+		float boxMax[4];
+	};
+
+	const GLuint EMPTY_LEAF_KEY = 0xffffffffu;
+}
+
+GlBarnesHut::GlBarnesHut(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms,
+	const fhl::Vec3f & _domainMin, float _domainSize, float _openingAngle) :
+	m_programs(_programs),
+	m_systems(_systems),
+	m_uniforms(_uniforms),
+	m_sort(_programs.sort, _systems.getCapacity(), _uniforms),
+	m_domainMin{_domainMin},
+	m_domainScale{MORTON_CELLS / _domainSize},
+	m_openingAngle{_openingAngle},
+	m_nodeBuffer{},
+	m_parentBuffer{},
+	m_visitBuffer{}
+{
+	// one internal node less than leaves; parents of the internal nodes followed by the ones of the leaves
+	const std::size_t capacity = m_systems.getCapacity();
+	glCreateBuffers(1, &m_nodeBuffer);
+	glNamedBufferStorage(m_nodeBuffer, capacity * sizeof(TreeNode), nullptr, 0);
+	glCreateBuffers(1, &m_parentBuffer);
+	glNamedBufferStorage(m_parentBuffer, 2u * capacity * sizeof(GLuint), nullptr, 0);
+	glCreateBuffers(1, &m_visitBuffer);
+	glNamedBufferStorage(m_visitBuffer, capacity * sizeof(GLuint), nullptr, 0);
+}
+
+GlBarnesHut::~GlBarnesHut()
+{
+	glDeleteBuffers(1, &m_nodeBuffer);
+	glDeleteBuffers(1, &m_parentBuffer);
+	glDeleteBuffers(1, &m_visitBuffer);
+}
+
+void GlBarnesHut::apply()
+{
+	// leaves are all slots in use, the ones of dead and unused particles are empty and sorted last
+	const std::size_t leafCount = m_systems.getUsedCapacity();
+	const GravityUniforms uniforms{{m_domainMin.x(), m_domainMin.y(), m_domainMin.z()}, m_domainScale, m_openingAngle * m_openingAngle, GLuint(leafCount), {}};
+	m_uniforms.push(UniformBlockBinding::GravityParamsBlock, uniforms);
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+	glClearNamedBufferData(m_sort.getKeyBuffer(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &EMPTY_LEAF_KEY);
+	glClearNamedBufferData(m_visitBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GlRadixSort::KeyBuffer, m_sort.getKeyBuffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GlRadixSort::ValueBuffer, m_sort.getValueBuffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::NodeBuffer, m_nodeBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::ParentBuffer, m_parentBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::VisitBuffer, m_visitBuffer);
+
+	glUseProgram(m_programs.keys);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	m_sort.sort(leafCount, 32u);
+	glUseProgram(m_programs.tree);
+	glDispatchCompute(GLuint((leafCount + 63u) / 64u), 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	glUseProgram(m_programs.summarize);
+	glDispatchCompute(GLuint((leafCount + 63u) / 64u), 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	glUseProgram(m_programs.gravity);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void GlBarnesHut::setPrograms(const Programs & _programs)
+{
+	m_programs = _programs;
+	m_sort.setPrograms(_programs.sort);
+}
+
+UniformUsage GlBarnesHut::getUniformUsage()
+{
+	return UniformUsage{1u, sizeof(GravityUniforms)} + GlRadixSort::getUniformUsage(32u);
+}
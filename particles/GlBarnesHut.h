@@ -0,0 +1,62 @@
+#ifndef GL_BARNES_HUT_H
+#define GL_BARNES_HUT_H
+
+#include "gl/flextGL.h"
+#include "GlGravitySolver.h"
+#include "maths/vectors.h"
+#include "GlRadixSort.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+/*
+ * Barnes-Hut gravity between all live particles on the GPU (barnes_hut.glsl), with the tree rebuilt from the positions every step:
+ * bh_keys.comp writes Morton codes, GlRadixSort sorts the particles by them, bh_tree.comp links a binary radix tree over
+ * the sorted particles with one invocation per internal node and bh_summarize.comp sums masses and bounds bottom-up.
+ * gravity.comp then walks the tree for every particle, so a step costs O(n log n). Every particle has unit mass.
+ * Must be created with the GL context current.
+ */
+class GlBarnesHut : public GlGravitySolver
+{
+public:
+	enum Bindings { NodeBuffer = 21, ParentBuffer = 22, VisitBuffer = 23 };
+
+	struct Programs
+	{
+		GLuint keys;
+		GLuint tree;
+		GLuint summarize;
+		GLuint gravity;
+		GlRadixSort::Programs sort;
+	};
+
+	/* _domainMin, _domainSize - cube in which Morton codes resolve positions, particles outside it only make the tree less efficient;
+	   _openingAngle - nodes smaller than it times their distance act as their centre of mass; the caller keeps ownership of _programs */
+	GlBarnesHut(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms,
+		const fhl::Vec3f & _domainMin, float _domainSize, float _openingAngle);
+	~GlBarnesHut() override;
+
+	GlBarnesHut(const GlBarnesHut &) = delete;
+	GlBarnesHut & operator=(const GlBarnesHut &) = delete;
+
+	/* rebuilds the tree, then walks it for every particle */
+	void apply() override;
+	/* uniform blocks an apply() pushes */
+	static UniformUsage getUniformUsage();
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(const Programs & _programs);
+
+private:
+	Programs m_programs;
+	const ParticleSystemManager & m_systems;
+	UniformRing & m_uniforms;
+	GlRadixSort m_sort;
+	fhl::Vec3f m_domainMin;
+	float m_domainScale;
+	float m_openingAngle;
+	GLuint m_nodeBuffer;
+	GLuint m_parentBuffer;
+	GLuint m_visitBuffer;
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef GL_GRAVITY_SOLVER_H
+#define GL_GRAVITY_SOLVER_H
+
+/* Common interface of the GPU solvers of gravity between all particles, run by GlParticleSimulator before every simulate.comp step */
+class GlGravitySolver
+{
+public:
+	virtual ~GlGravitySolver() = default;
+
+	/* adds the accelerations times dt of the bound SimulationParams to the velocities, from the positions at SSBO binding 0 */
+	virtual void apply() = 0;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "GlParticleCompactor.h"
+#include "Morton.h"
+
+#include <algorithm>
+
+namespace
+{
+	enum UniformBlockBinding { CompactParamsBlock = 4 };
+
+	// std140 CompactParams block of compact.glsl
+	struct CompactUniforms
+	{
+		float killCenter[3];
+		float killRadius;
+		GLuint moveWords;
+		GLuint movePhase;
+		GLuint mortonBits;
+		GLuint padding;
+		float mortonMin[3];
+		float mortonScale;
+	};
+
+	const GLuint UNORDERED_KEY = 0xffffffffu; // of compact.glsl
+}
+
+GlParticleCompactor::GlParticleCompactor(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms) :
+	m_programs(_programs),
+	m_systems(_systems),
+	m_uniforms(_uniforms),
+	m_mortonScale{},
+	m_groupPrefixBuffer{},
+	m_destinationBuffer{},
+	m_scratchBuffer{},
+	m_scratchStride{0u}
+{
+	// a count per workgroup and the total
+	glCreateBuffers(1, &m_groupPrefixBuffer);
+	glNamedBufferStorage(m_groupPrefixBuffer, (m_systems.getCapacity() / ParticleSystemManager::GroupSize + 1u) * sizeof(GLuint), nullptr, 0);
+	glCreateBuffers(1, &m_destinationBuffer);
+	glNamedBufferStorage(m_destinationBuffer, m_systems.getCapacity() * sizeof(GLuint), nullptr, 0);
+}
+
+GlParticleCompactor::~GlParticleCompactor()
+{
+	glDeleteBuffers(1, &m_groupPrefixBuffer);
+	glDeleteBuffers(1, &m_destinationBuffer);
+	glDeleteBuffers(1, &m_scratchBuffer);
+}
+
+void GlParticleCompactor::compact(const fhl::Vec3f & _killCenter, float _killRadius, const std::vector<Attribute> & _attributes)
+{
+	std::size_t stride = m_scratchStride;
+	for (const Attribute & attribute : _attributes)
+		stride = attribute.stride > stride ? attribute.stride : stride;
+	if (stride > m_scratchStride)
+	{ // one scratch buffer for all attributes, sized for the widest
+		glDeleteBuffers(1, &m_scratchBuffer);
+		glCreateBuffers(1, &m_scratchBuffer);
+		glNamedBufferStorage(m_scratchBuffer, m_systems.getCapacity() * stride, nullptr, 0);
+		m_scratchStride = stride;
+	}
+
+	// system indices above the Morton codes, coarsened by whole levels to fit the keys below UNORDERED_KEY
+	unsigned systemBits = 0u;
+	while ((std::size_t(1u) << systemBits) < m_systems.getSystemCount())
+		++systemBits;
+	const GLuint mortonBits = std::min(30u, (31u - systemBits) / 3u * 3u);
+	CompactUniforms uniforms{{_killCenter.x(), _killCenter.y(), _killCenter.z()}, _killRadius, 0u, 0u, mortonBits, 0u,
+		{m_mortonMin.x(), m_mortonMin.y(), m_mortonMin.z()}, m_mortonScale};
+	m_uniforms.push(UniformBlockBinding::CompactParamsBlock, uniforms);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::GroupPrefixBuffer, m_groupPrefixBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::DestinationBuffer, m_destinationBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::MoveScratchBuffer, m_scratchBuffer);
+
+	glUseProgram(m_programs.count);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	glUseProgram(m_programs.scan);
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	glUseProgram(m_programs.scatter);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	if (m_sort)
+	{
+		const std::size_t used = m_systems.getUsedCapacity();
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glClearNamedBufferData(m_sort->getKeyBuffer(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &UNORDERED_KEY);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GlRadixSort::KeyBuffer, m_sort->getKeyBuffer());
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GlRadixSort::ValueBuffer, m_sort->getValueBuffer());
+		glUseProgram(m_programs.keys);
+		m_systems.dispatch();
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		m_sort->sort(used, systemBits + mortonBits);
+		glUseProgram(m_programs.order);
+		glDispatchCompute(GLuint(used / ParticleSystemManager::GroupSize), 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+
+	glUseProgram(m_programs.move);
+	for (const Attribute & attribute : _attributes)
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::MoveDataBuffer, attribute.buffer);
+		for (GLuint phase = 0u; phase < 2u; ++phase)
+		{
+			uniforms.moveWords = GLuint(attribute.stride / sizeof(GLuint));
+			uniforms.movePhase = phase;
+			m_uniforms.push(UniformBlockBinding::CompactParamsBlock, uniforms);
+			m_systems.dispatch();
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		}
+	}
+
+	glUseProgram(m_programs.finalize);
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+void GlParticleCompactor::setMortonOrder(const fhl::Vec3f & _min, float _size)
+{
+	m_sort = std::make_unique<GlRadixSort>(m_programs.sort, m_systems.getCapacity(), m_uniforms);
+	m_mortonMin = _min;
+	m_mortonScale = MORTON_CELLS / _size;
+}
+
+void GlParticleCompactor::setPrograms(const Programs & _programs)
+{
+	m_programs = _programs;
+	if (m_sort)
+		m_sort->setPrograms(_programs.sort);
+}
+
+UniformUsage GlParticleCompactor::getUniformUsage(std::size_t _attributes, bool _mortonOrder)
+{
+	// the scan and scatter parameters, then both move phases of every attribute
+	const UniformUsage usage = UniformUsage{1u, sizeof(CompactUniforms)} * (1u + 2u * _attributes);
+	return _mortonOrder ? usage + GlRadixSort::getUniformUsage(32u) : usage;
+}
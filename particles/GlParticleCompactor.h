@@ -0,0 +1,81 @@
+#ifndef GL_PARTICLE_COMPACTOR_H
+#define GL_PARTICLE_COMPACTOR_H
+
+#include "gl/flextGL.h"
+#include "GlRadixSort.h"
+#include "maths/vectors.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+ * Packs the surviving particles of every system to the start of its range on the GPU, so that dispatches and draws
+ * only cover live particles again: dead ones (lifetime.glsl) and ones outside the kill sphere are removed.
+ * compact_count.comp counts survivors per workgroup, compact_scan.comp prefix sums the counts, compact_scatter.comp
+ * computes destinations keeping the particle order and compact_move.comp moves every attribute through a scratch buffer;
+ * compact_finalize.comp then sets the counts (SSBO binding 6), so nothing is read back.
+ * With Morton ordering the survivors are also sorted by position within every system: compact_keys.comp writes their Morton codes
+ * below their system indices, GlRadixSort sorts them and compact_order.comp turns the sorted order into the destinations.
+ * Must be created with the GL context current.
+ */
+class GlParticleCompactor
+{
+public:
+	enum Bindings { GroupPrefixBuffer = 11, DestinationBuffer = 12, MoveDataBuffer = 13, MoveScratchBuffer = 14 };
+
+	struct Programs
+	{
+		GLuint count;
+		GLuint scan;
+		GLuint scatter;
+		GLuint move;
+		GLuint finalize;
+		GLuint keys; // Morton ordering only, like sort
+		GLuint order;
+		GlRadixSort::Programs sort;
+	};
+
+	/* a buffer of per particle data moved along, _stride a multiple of 4 bytes */
+	struct Attribute
+	{
+		GLuint buffer;
+		std::size_t stride;
+	};
+
+	/* the caller keeps ownership of _programs */
+	GlParticleCompactor(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms);
+	~GlParticleCompactor();
+
+	GlParticleCompactor(const GlParticleCompactor &) = delete;
+	GlParticleCompactor & operator=(const GlParticleCompactor &) = delete;
+
+	/* _attributes - all per particle buffers, positions must be among them; _killRadius may be infinite */
+	void compact(const fhl::Vec3f & _killCenter, float _killRadius, const std::vector<Attribute> & _attributes);
+	/* uniform blocks a compact() of _attributes attributes pushes, with or without Morton ordering */
+	static UniformUsage getUniformUsage(std::size_t _attributes, bool _mortonOrder);
+
+	/* sorts the survivors of later compactions by the Morton codes of their positions, quantized in the cube from _min of side _size,
+	   which keeps particles close in space close in the buffers; needs the ordering programs */
+	void setMortonOrder(const fhl::Vec3f & _min, float _size);
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(const Programs & _programs);
+
+private:
+	Programs m_programs;
+	const ParticleSystemManager & m_systems;
+	UniformRing & m_uniforms;
+	std::unique_ptr<GlRadixSort> m_sort; // when ordering
+	fhl::Vec3f m_mortonMin;
+	float m_mortonScale;
+
+	GLuint m_groupPrefixBuffer;
+	GLuint m_destinationBuffer;
+	GLuint m_scratchBuffer;
+	std::size_t m_scratchStride;
+};
+
+#endif
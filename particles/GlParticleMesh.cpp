@@ -0,0 +1,87 @@
+#include "GlParticleMesh.h"
+
+namespace
+{
+	enum UniformBlockBinding { ParticleMeshParamsBlock = 7 };
+
+	// std140 ParticleMeshParams block of particle_mesh.glsl
+	struct ParticleMeshUniforms
+	{
+		float domainMin[3];
+		float cellsPerUnit;
+		GLuint fftAxis;
+		float fftSign;
+		GLuint padding[2];
+	};
+}
+
+GlParticleMesh::GlParticleMesh(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms,
+	const fhl::Vec3f & _domainMin, float _domainSize, unsigned _gridSize) :
+	m_programs(_programs),
+	m_systems(_systems),
+	m_uniforms(_uniforms),
+	m_domainMin{_domainMin},
+	m_cellsPerUnit{_gridSize / _domainSize},
+	m_gridSize{_gridSize},
+	m_densityBuffer{},
+	m_fieldBuffer{}
+{
+	const std::size_t cells = std::size_t(m_gridSize) * m_gridSize * m_gridSize;
+	glCreateBuffers(1, &m_densityBuffer);
+	glNamedBufferStorage(m_densityBuffer, cells * sizeof(GLuint), nullptr, 0);
+	glCreateBuffers(1, &m_fieldBuffer);
+	glNamedBufferStorage(m_fieldBuffer, cells * 2u * sizeof(float), nullptr, 0);
+}
+
+GlParticleMesh::~GlParticleMesh()
+{
+	glDeleteBuffers(1, &m_densityBuffer);
+	glDeleteBuffers(1, &m_fieldBuffer);
+}
+
+void GlParticleMesh::apply()
+{
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+	glClearNamedBufferData(m_densityBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::DensityBuffer, m_densityBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::FieldBuffer, m_fieldBuffer);
+
+	pushParams(0u, -1.f);
+	glUseProgram(m_programs.deposit);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	// forward transform, the first pass reading the density
+	for (GLuint axis = 0u; axis < 3u; ++axis)
+	{
+		if (axis)
+			pushParams(axis, -1.f);
+		glUseProgram(axis ? m_programs.fft : m_programs.fftLoad);
+		glDispatchCompute(m_gridSize, m_gridSize, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+	glUseProgram(m_programs.solve);
+	glDispatchCompute(m_gridSize, m_gridSize, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	glUseProgram(m_programs.fft);
+	for (GLuint axis = 0u; axis < 3u; ++axis)
+	{
+		pushParams(axis, 1.f);
+		glDispatchCompute(m_gridSize, m_gridSize, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+	glUseProgram(m_programs.force);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void GlParticleMesh::pushParams(GLuint _fftAxis, float _fftSign)
+{
+	m_uniforms.push(UniformBlockBinding::ParticleMeshParamsBlock,
+		ParticleMeshUniforms{{m_domainMin.x(), m_domainMin.y(), m_domainMin.z()}, m_cellsPerUnit, _fftAxis, _fftSign, {}});
+}
+
+UniformUsage GlParticleMesh::getUniformUsage()
+{
+	// deposit with the forward transform, then the inverse one
+	return UniformUsage{1u, sizeof(ParticleMeshUniforms)} * 6u;
+}
@@ -0,0 +1,59 @@
+#ifndef GL_PARTICLE_MESH_H
+#define GL_PARTICLE_MESH_H
+
+#include "gl/flextGL.h"
+#include "GlGravitySolver.h"
+#include "maths/vectors.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+/*
+ * Particle-mesh gravity on the GPU (particle_mesh.glsl), linear in the particle count: pm_deposit.comp spreads the particles' mass
+ * over a periodic grid cloud-in-cell, pm_fft.comp transforms it line by line along each axis, pm_solve.comp turns the spectrum into
+ * the one of the potential and after the inverse transform pm_force.comp interpolates its gradient back to the particles.
+ * Forces are resolved down to about two cells, the grid costs O(g^3 log g) for g cells per axis. Must be created with the GL context current.
+ */
+class GlParticleMesh : public GlGravitySolver
+{
+public:
+	enum Bindings { DensityBuffer = 24, FieldBuffer = 25 };
+
+	struct Programs
+	{
+		GLuint deposit;
+		GLuint fftLoad; // pm_fft.comp compiled with PM_LOAD_DENSITY
+		GLuint fft;
+		GLuint solve;
+		GLuint force;
+	};
+
+	/* _domainMin, _domainSize - cube covered by the grid, which wraps around outside it; _gridSize - cells per axis
+	   (PM_GRID of the programs, a power of two); the caller keeps ownership of _programs */
+	GlParticleMesh(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms,
+		const fhl::Vec3f & _domainMin, float _domainSize, unsigned _gridSize);
+	~GlParticleMesh() override;
+
+	GlParticleMesh(const GlParticleMesh &) = delete;
+	GlParticleMesh & operator=(const GlParticleMesh &) = delete;
+
+	void apply() override;
+	/* uniform blocks an apply() pushes */
+	static UniformUsage getUniformUsage();
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(const Programs & _programs) { m_programs = _programs; }
+
+private:
+	void pushParams(GLuint _fftAxis, float _fftSign);
+
+	Programs m_programs;
+	const ParticleSystemManager & m_systems;
+	UniformRing & m_uniforms;
+	fhl::Vec3f m_domainMin;
+	float m_cellsPerUnit;
+	GLuint m_gridSize;
+	GLuint m_densityBuffer;
+	GLuint m_fieldBuffer;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "GlParticleSimulator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+	enum UniformBlockBinding { SimulationParamsBlock = 0, ForceFieldParamsBlock = 8 };
+
+	// std140 SimulationParams block of simulate.comp
+	struct SimulationUniforms
+	{
+		float attractorPosition[3];
+		float dt;
+	};
+
+	// std140 ForceField struct of force_fields.glsl
+	struct ForceFieldData
+	{
+		float position[3];
+		std::uint32_t type;
+		float direction[3];
+		float strength;
+		float radius;
+		float phase;
+		float padding[2];
+	};
+
+	// std140 ForceFieldParams block of force_fields.glsl, MAX_FORCE_FIELDS is GlParticleSimulator::MaxForceFields
+	struct ForceFieldUniforms
+	{
+		std::uint32_t forceFieldCount;
+		std::uint32_t padding[3];
+		ForceFieldData forceFields[GlParticleSimulator::MaxForceFields];
+	};
+	static_assert(sizeof(ForceFieldUniforms) == 16 + 48 * GlParticleSimulator::MaxForceFields, "ForceFieldUniforms must match the std140 layout of ForceFieldParams");
+}
+
+void GlParticleSimulator::update(const SimulationParams & _params)
+{
+	const fhl::Vec3f & attractor = _params.attractorPosition;
+	m_uniforms.push(UniformBlockBinding::SimulationParamsBlock, SimulationUniforms{{attractor.x(), attractor.y(), attractor.z()}, _params.dt});
+	ForceFieldUniforms fields{};
+	fields.forceFieldCount = std::uint32_t(std::min<std::size_t>(_params.forceFieldCount, MaxForceFields));
+	for (std::uint32_t i = 0u; i < fields.forceFieldCount; ++i)
+	{
+		const ForceField & field = _params.forceFields[i];
+		fields.forceFields[i] = ForceFieldData{{field.position.x(), field.position.y(), field.position.z()}, std::uint32_t(field.type),
+			{field.direction.x(), field.direction.y(), field.direction.z()}, field.strength, field.radius, field.phase, {}};
+	}
+	m_uniforms.push(UniformBlockBinding::ForceFieldParamsBlock, fields);
+	if (m_hash)
+	{ // interactions only read positions, which the step changes afterwards
+		m_hash->build();
+		glUseProgram(m_interactionProgram);
+		m_systems.dispatch();
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+	if (m_gravity)
+		m_gravity->apply();
+	glUseProgram(_params.attractorActive ? m_attractorProgram : m_program);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+UniformUsage GlParticleSimulator::getUniformUsage()
+{
+	return UniformUsage{2u, sizeof(SimulationUniforms) + sizeof(ForceFieldUniforms)};
+}
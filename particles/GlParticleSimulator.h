@@ -0,0 +1,47 @@
+#ifndef GL_PARTICLE_SIMULATOR_H
+#define GL_PARTICLE_SIMULATOR_H
+
+#include "gl/flextGL.h"
+#include "GlGravitySolver.h"
+#include "GlSpatialHash.h"
+#include "ParticleSimulator.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+/* Runs simulate.comp over all systems of _systems in one dispatch, on buffers bound to SSBO bindings 0 (positions) and 1 (velocities).
+   Parameters go through _uniforms.
+   _attractorProgram is the variant compiled with ATTRACTOR defined, picked while the attractor is active.
+   The first MaxForceFields force fields of the parameters go to the MAX_FORCE_FIELDS array of force_fields.glsl, further ones are ignored.
+   With an interaction set, every step first rebuilds the hash grid and runs interact.comp on the velocities,
+   then applies gravity if it is set */
+class GlParticleSimulator : public ParticleSimulator
+{
+public:
+	enum { MaxForceFields = 32 };
+
+	GlParticleSimulator(GLuint _program, GLuint _attractorProgram, const ParticleSystemManager & _systems, UniformRing & _uniforms) :
+		m_program{_program}, m_attractorProgram{_attractorProgram}, m_interactionProgram{}, m_hash{}, m_gravity{}, m_systems(_systems), m_uniforms(_uniforms) {}
+
+	void update(const SimulationParams & _params) override;
+	/* uniform blocks an update() pushes */
+	static UniformUsage getUniformUsage();
+	std::size_t getParticleCount() const override { return m_systems.getCapacity(); }
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(GLuint _program, GLuint _attractorProgram) { m_program = _program; m_attractorProgram = _attractorProgram; }
+	/* _program - interact.comp, nullptr _hash disables interactions; the caller keeps ownership of both */
+	void setInteraction(GLuint _program, GlSpatialHash * _hash) { m_interactionProgram = _program; m_hash = _hash; }
+	/* nullptr disables gravity, the caller keeps ownership */
+	void setGravity(GlGravitySolver * _gravity) { m_gravity = _gravity; }
+
+private:
+	GLuint m_program;
+	GLuint m_attractorProgram;
+	GLuint m_interactionProgram;
+	GlSpatialHash * m_hash;
+	GlGravitySolver * m_gravity;
+	const ParticleSystemManager & m_systems;
+	UniformRing & m_uniforms;
+};
+
+#endif
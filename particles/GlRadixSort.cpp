@@ -0,0 +1,80 @@
+#include "GlRadixSort.h"
+
+namespace
+{
+	enum UniformBlockBinding { RadixParamsBlock = 5 };
+
+	// std140 RadixParams block of radix_sort.glsl
+	struct RadixUniforms
+	{
+		GLuint sortCount;
+		GLuint shift;
+		GLuint tileCount;
+		GLuint padding;
+	};
+
+	// an even number of passes leaves the result in the first buffers
+	unsigned getPassCount(unsigned _keyBits)
+	{
+		const unsigned passes = (_keyBits + GlRadixSort::DigitBits - 1u) / GlRadixSort::DigitBits;
+		return passes + (passes & 1u);
+	}
+}
+
+GlRadixSort::GlRadixSort(const Programs & _programs, std::size_t _capacity, UniformRing & _uniforms) :
+	m_programs(_programs),
+	m_uniforms(_uniforms),
+	m_keyBuffers{},
+	m_valueBuffers{},
+	m_tileCountBuffer{}
+{
+	glCreateBuffers(2, m_keyBuffers);
+	glCreateBuffers(2, m_valueBuffers);
+	for (int i = 0; i < 2; ++i)
+	{
+		glNamedBufferStorage(m_keyBuffers[i], _capacity * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		glNamedBufferStorage(m_valueBuffers[i], _capacity * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	}
+	glCreateBuffers(1, &m_tileCountBuffer);
+	glNamedBufferStorage(m_tileCountBuffer, (1u << DigitBits) * ((_capacity + TileSize - 1u) / TileSize) * sizeof(GLuint), nullptr, 0);
+}
+
+GlRadixSort::~GlRadixSort()
+{
+	glDeleteBuffers(2, m_keyBuffers);
+	glDeleteBuffers(2, m_valueBuffers);
+	glDeleteBuffers(1, &m_tileCountBuffer);
+}
+
+void GlRadixSort::sort(std::size_t _count, unsigned _keyBits)
+{
+	const GLuint tiles = GLuint((_count + TileSize - 1u) / TileSize);
+	const unsigned passes = getPassCount(_keyBits);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::TileCountBuffer, m_tileCountBuffer);
+	for (unsigned pass = 0u; pass < passes && tiles; ++pass)
+	{
+		const int in = pass & 1u, out = in ^ 1;
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::KeyBuffer, m_keyBuffers[in]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::ValueBuffer, m_valueBuffers[in]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::KeyOutBuffer, m_keyBuffers[out]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::ValueOutBuffer, m_valueBuffers[out]);
+		m_uniforms.push(UniformBlockBinding::RadixParamsBlock, RadixUniforms{GLuint(_count), pass * DigitBits, tiles, 0u});
+
+		glUseProgram(m_programs.count);
+		glDispatchCompute(tiles, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		glUseProgram(m_programs.scan);
+		glDispatchCompute(1, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		glUseProgram(m_programs.scatter);
+		glDispatchCompute(tiles, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::KeyBuffer, m_keyBuffers[0]);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::ValueBuffer, m_valueBuffers[0]);
+}
+
+UniformUsage GlRadixSort::getUniformUsage(unsigned _keyBits)
+{
+	return UniformUsage{1u, sizeof(RadixUniforms)} * getPassCount(_keyBits);
+}
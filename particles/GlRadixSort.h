@@ -0,0 +1,56 @@
+#ifndef GL_RADIX_SORT_H
+#define GL_RADIX_SORT_H
+
+#include "gl/flextGL.h"
+#include "UniformRing.h"
+
+#include <cstddef>
+
+/*
+ * Stable LSD radix sort of up to _capacity uint key/value pairs on the GPU, 4 bits per pass (radix_sort.glsl):
+ * radix_count.comp histograms the digit of every tile, radix_scan.comp prefix sums the histograms in digit-major order
+ * and radix_scatter.comp moves the tiles' elements to their destinations. Every pass reads and writes whole buffers,
+ * so sorting n pairs costs O(n) per pass. Must be created with the GL context current.
+ */
+class GlRadixSort
+{
+public:
+	enum Bindings { KeyBuffer = 15, ValueBuffer = 16, KeyOutBuffer = 17, ValueOutBuffer = 18, TileCountBuffer = 19 };
+	enum { DigitBits = 4, TileSize = 2048 };
+
+	struct Programs
+	{
+		GLuint count;
+		GLuint scan;
+		GLuint scatter;
+	};
+
+	/* the caller keeps ownership of _programs */
+	GlRadixSort(const Programs & _programs, std::size_t _capacity, UniformRing & _uniforms);
+	~GlRadixSort();
+
+	GlRadixSort(const GlRadixSort &) = delete;
+	GlRadixSort & operator=(const GlRadixSort &) = delete;
+
+	/* buffers of _capacity keys and values, filled by the caller before sort() */
+	GLuint getKeyBuffer() const { return m_keyBuffers[0]; }
+	GLuint getValueBuffer() const { return m_valueBuffers[0]; }
+
+	/* sorts the first _count pairs by the low _keyBits bits of the keys, keeping the order of equal keys;
+	   the sorted pairs are left in getKeyBuffer() and getValueBuffer(), bound at KeyBuffer and ValueBuffer */
+	void sort(std::size_t _count, unsigned _keyBits);
+	/* uniform blocks a sort() by _keyBits bits pushes */
+	static UniformUsage getUniformUsage(unsigned _keyBits);
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(const Programs & _programs) { m_programs = _programs; }
+
+private:
+	Programs m_programs;
+	UniformRing & m_uniforms;
+	GLuint m_keyBuffers[2];
+	GLuint m_valueBuffers[2];
+	GLuint m_tileCountBuffer;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "GlSpatialHash.h"
+#include "SimulationConstants.h"
+
+namespace
+{
+	const GLuint CELL_COUNT = 1u << (3 * constants::HASH_CELL_BITS);
+	const GLuint EMPTY_KEY = CELL_COUNT; // HASH_EMPTY_KEY of spatial_hash.glsl
+	const unsigned KEY_BITS = 3 * constants::HASH_CELL_BITS + 1;
+}
+
+GlSpatialHash::GlSpatialHash(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms) :
+	m_programs(_programs),
+	m_systems(_systems),
+	m_sort(_programs.sort, _systems.getCapacity(), _uniforms),
+	m_cellBuffer{}
+{
+	glCreateBuffers(1, &m_cellBuffer);
+	glNamedBufferStorage(m_cellBuffer, CELL_COUNT * 2u * sizeof(GLuint), nullptr, 0);
+}
+
+GlSpatialHash::~GlSpatialHash()
+{
+	glDeleteBuffers(1, &m_cellBuffer);
+}
+
+void GlSpatialHash::build()
+{
+	// slots of dead and unused particles keep the empty key, sorted after all cells
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+	glClearNamedBufferData(m_sort.getKeyBuffer(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &EMPTY_KEY);
+	glClearNamedBufferData(m_cellBuffer, GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GlRadixSort::KeyBuffer, m_sort.getKeyBuffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GlRadixSort::ValueBuffer, m_sort.getValueBuffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::CellBuffer, m_cellBuffer);
+
+	glUseProgram(m_programs.keys);
+	m_systems.dispatch();
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+	const std::size_t count = m_systems.getUsedCapacity();
+	m_sort.sort(count, KEY_BITS);
+	glUseProgram(m_programs.cells);
+	glDispatchCompute(GLuint((count + 63u) / 64u), 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void GlSpatialHash::setPrograms(const Programs & _programs)
+{
+	m_programs = _programs;
+	m_sort.setPrograms(_programs.sort);
+}
+
+UniformUsage GlSpatialHash::getUniformUsage()
+{
+	return GlRadixSort::getUniformUsage(KEY_BITS);
+}
@@ -0,0 +1,50 @@
+#ifndef GL_SPATIAL_HASH_H
+#define GL_SPATIAL_HASH_H
+
+#include "gl/flextGL.h"
+#include "GlRadixSort.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+/*
+ * Hash grid of the live particles for neighbour queries on the GPU (spatial_hash.glsl), rebuilt from scratch by build():
+ * hash_keys.comp writes the cell key of every live particle, GlRadixSort sorts the particle indices by key
+ * and hash_cells.comp stores where every cell's run of particles begins and ends. Every stage is O(particles),
+ * plus clearing the cell table. The sorted particles stay bound at SSBO binding 16 and the cell ranges at 20.
+ * Must be created with the GL context current.
+ */
+class GlSpatialHash
+{
+public:
+	enum Bindings { CellBuffer = 20 };
+
+	struct Programs
+	{
+		GLuint keys;
+		GLuint cells;
+		GlRadixSort::Programs sort;
+	};
+
+	/* the caller keeps ownership of _programs */
+	GlSpatialHash(const Programs & _programs, const ParticleSystemManager & _systems, UniformRing & _uniforms);
+	~GlSpatialHash();
+
+	GlSpatialHash(const GlSpatialHash &) = delete;
+	GlSpatialHash & operator=(const GlSpatialHash &) = delete;
+
+	/* from the positions at SSBO binding 0 */
+	void build();
+	/* uniform blocks a build() pushes */
+	static UniformUsage getUniformUsage();
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(const Programs & _programs);
+
+private:
+	Programs m_programs;
+	const ParticleSystemManager & m_systems;
+	GlRadixSort m_sort;
+	GLuint m_cellBuffer;
+};
+
+#endif
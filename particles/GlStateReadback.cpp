@@ -0,0 +1,90 @@
+#include "GlStateReadback.h"
+#include "Recording.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	void waitFence(GLsync _fence)
+	{
+		GLenum status;
+		do
+			status = glClientWaitSync(_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000u);
+		while (status == GL_TIMEOUT_EXPIRED);
+	}
+}
+
+GlStateReadback::GlStateReadback(GLsizeiptr _positionsSize, GLsizeiptr _velocitiesSize, unsigned _slots) :
+	m_buffer{},
+	m_mapping{},
+	m_positionsSize{_positionsSize},
+	m_velocitiesSize{_velocitiesSize},
+	m_slots(std::max(_slots, 1u), Slot{nullptr, 0u}),
+	m_stalls{0u}
+{
+	const GLsizeiptr size = (m_positionsSize + m_velocitiesSize) * GLsizeiptr(m_slots.size());
+	const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glCreateBuffers(1, &m_buffer);
+	glNamedBufferStorage(m_buffer, size, nullptr, flags);
+	m_mapping = static_cast<unsigned char *>(glMapNamedBufferRange(m_buffer, 0, size, flags));
+	for (std::size_t i = m_slots.size(); i > 0u; --i)
+		m_free.push_back(i - 1u);
+}
+
+GlStateReadback::~GlStateReadback()
+{
+	for (const Slot & slot : m_slots)
+		if (slot.fence)
+			glDeleteSync(slot.fence);
+	glUnmapNamedBuffer(m_buffer);
+	glDeleteBuffers(1, &m_buffer);
+}
+
+void GlStateReadback::capture(std::uint64_t _step, GLuint _positions, GLuint _velocities, RecordingWriter & _recorder)
+{
+	flush(_recorder, false);
+	if (m_free.empty())
+	{
+		++m_stalls;
+		waitFence(m_slots[m_inFlight.front()].fence);
+		flush(_recorder, false);
+	}
+
+	const std::size_t slot = m_free.back();
+	m_free.pop_back();
+	const GLintptr offset = GLintptr(slot) * (m_positionsSize + m_velocitiesSize);
+	// the simulation wrote both buffers from shaders
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+	glCopyNamedBufferSubData(_positions, m_buffer, 0, offset, m_positionsSize);
+	glCopyNamedBufferSubData(_velocities, m_buffer, 0, offset + m_positionsSize, m_velocitiesSize);
+	m_slots[slot] = Slot{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _step};
+	m_inFlight.push_back(slot);
+}
+
+void GlStateReadback::flush(RecordingWriter & _recorder, bool _wait)
+{
+	while (!m_inFlight.empty())
+	{
+		const std::size_t slot = m_inFlight.front();
+		if (_wait)
+			waitFence(m_slots[slot].fence);
+		else if (glClientWaitSync(m_slots[slot].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0u) == GL_TIMEOUT_EXPIRED)
+			return;
+		m_inFlight.pop_front();
+		record(slot, _recorder);
+	}
+}
+
+void GlStateReadback::record(std::size_t _slot, RecordingWriter & _recorder)
+{
+	Slot & slot = m_slots[_slot];
+	glDeleteSync(slot.fence);
+	slot.fence = nullptr;
+	const unsigned char * const data = m_mapping + GLintptr(_slot) * (m_positionsSize + m_velocitiesSize);
+	_recorder.record(slot.step, [&](void * _positions, void * _velocities) {
+		std::memcpy(_positions, data, std::size_t(m_positionsSize));
+		std::memcpy(_velocities, data + m_positionsSize, std::size_t(m_velocitiesSize));
+	});
+	m_free.push_back(_slot);
+}
@@ -0,0 +1,54 @@
+#ifndef GL_STATE_READBACK_H
+#define GL_STATE_READBACK_H
+
+#include "gl/flextGL.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class RecordingWriter;
+
+/*
+ * Asynchronous readback of the particle state for recording. capture() copies the position and velocity buffers
+ * into a free slot of persistently mapped staging buffers and fences the copy; the slot is handed to the recording
+ * writer by flush() only once its fence has signalled, so the simulation never waits for the step it just issued.
+ * With all _slots in flight capture() waits for the oldest one, issued _slots steps earlier.
+ */
+class GlStateReadback
+{
+public:
+	GlStateReadback(GLsizeiptr _positionsSize, GLsizeiptr _velocitiesSize, unsigned _slots);
+	~GlStateReadback();
+
+	GlStateReadback(const GlStateReadback &) = delete;
+	GlStateReadback & operator=(const GlStateReadback &) = delete;
+
+	void capture(std::uint64_t _step, GLuint _positions, GLuint _velocities, RecordingWriter & _recorder);
+	/* records the slots whose copies completed, in capture order; with _wait all of them */
+	void flush(RecordingWriter & _recorder, bool _wait);
+
+	/* times capture() had to wait for a slot */
+	std::size_t getStalls() const { return m_stalls; }
+
+private:
+	struct Slot
+	{
+		GLsync fence;
+		std::uint64_t step;
+	};
+
+	void record(std::size_t _slot, RecordingWriter & _recorder);
+
+	GLuint m_buffer; // slots one after another, positions followed by velocities
+	unsigned char * m_mapping;
+	GLsizeiptr m_positionsSize;
+	GLsizeiptr m_velocitiesSize;
+	std::vector<Slot> m_slots;
+	std::vector<std::size_t> m_free;
+	std::deque<std::size_t> m_inFlight;
+	std::size_t m_stalls;
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+GpuProfiler::GpuProfiler(std::size_t _historyFrames) :
+	m_historyFrames{std::max<std::size_t>(_historyFrames, 1u)},
+	m_frames{},
+	m_frame{0u},
+	m_droppedFrames{0u},
+	m_traceTrack{},
+	m_gpuToTraceTime{}
+{
+	if (fhl::trace::isEnabled())
+	{
+		m_traceTrack = fhl::trace::createTrack("GPU");
+		GLint64 gpuTime{};
+		glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+		m_gpuToTraceTime = std::int64_t(fhl::trace::now()) - gpuTime;
+	}
+}
+
+GpuProfiler::~GpuProfiler()
+{
+	for (FrameQueries & frame : m_frames)
+		if (!frame.pool.empty())
+			glDeleteQueries(GLsizei(frame.pool.size()), frame.pool.data());
+}
+
+void GpuProfiler::beginFrame()
+{
+	FrameQueries & frame = m_frames[m_frame % RING_FRAMES];
+	if (frame.used)
+	{ // queries complete in order, so the last one issued being available means all are
+		GLint available{};
+		glGetQueryObjectiv(frame.pool[frame.used - 1u], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available)
+			collect(frame);
+		else
+			++m_droppedFrames;
+	}
+	frame.used = 0u;
+	frame.passes.clear();
+	frame.open.clear();
+	frame.recording = true;
+}
+
+void GpuProfiler::endFrame()
+{
+	m_frames[m_frame % RING_FRAMES].recording = false;
+	++m_frame;
+}
+
+void GpuProfiler::beginPass(const char * _name)
+{
+	FrameQueries & frame = m_frames[m_frame % RING_FRAMES];
+	if (!frame.recording)
+		return;
+	const GLuint query = acquireQuery(frame);
+	glQueryCounter(query, GL_TIMESTAMP);
+	frame.open.push_back(frame.passes.size());
+	frame.passes.push_back(PassQuery{findPass(_name), query, 0u});
+}
+
+void GpuProfiler::endPass()
+{
+	FrameQueries & frame = m_frames[m_frame % RING_FRAMES];
+	if (!frame.recording || frame.open.empty())
+		return;
+	const GLuint query = acquireQuery(frame);
+	glQueryCounter(query, GL_TIMESTAMP);
+	frame.passes[frame.open.back()].end = query;
+	frame.open.pop_back();
+}
+
+void GpuProfiler::flush()
+{
+	for (std::size_t i = 0u; i < RING_FRAMES; ++i)
+	{ // the next slot to be reused holds the oldest frame
+		FrameQueries & frame = m_frames[(m_frame + i) % RING_FRAMES];
+		if (frame.recording || !frame.used)
+			continue;
+		collect(frame);
+		frame.used = 0u;
+		frame.passes.clear();
+	}
+}
+
+std::vector<GpuProfiler::PassStats> GpuProfiler::getStats() const
+{
+	std::vector<PassStats> stats;
+	std::vector<float> sorted;
+	for (const Pass & pass : m_passes)
+	{
+		if (!pass.samples)
+			continue;
+		sorted = pass.history;
+		std::sort(sorted.begin(), sorted.end());
+		float sum = 0.f;
+		for (float t : sorted)
+			sum += t;
+		const std::size_t p99 = std::size_t(std::ceil(.99 * sorted.size())) - 1u;
+		stats.push_back(PassStats{pass.name, pass.samples, sorted.front(), sum / sorted.size(), sorted[p99]});
+	}
+	return stats;
+}
+
+void GpuProfiler::printStats() const
+{
+	std::printf("GPU pass        min ms   avg ms   p99 ms  (last %zu frames, %zu dropped)\n", m_historyFrames, m_droppedFrames);
+	for (const PassStats & pass : getStats())
+		std::printf("  %-12s %8.3f %8.3f %8.3f\n", pass.name, pass.min, pass.avg, pass.p99);
+}
+
+GLuint GpuProfiler::acquireQuery(FrameQueries & _frame)
+{
+	if (_frame.used == _frame.pool.size())
+	{
+		GLuint query{};
+		glGenQueries(1, &query);
+		_frame.pool.push_back(query);
+	}
+	return _frame.pool[_frame.used++];
+}
+
+std::size_t GpuProfiler::findPass(const char * _name)
+{
+	for (std::size_t i = 0u; i < m_passes.size(); ++i)
+		if (m_passes[i].name == _name)
+			return i;
+	m_passes.push_back(Pass{_name, {}, 0u});
+	return m_passes.size() - 1u;
+}
+
+void GpuProfiler::collect(FrameQueries & _frame)
+{
+	m_frameTimes.assign(m_passes.size(), -1.f);
+	for (const PassQuery & query : _frame.passes)
+	{
+		if (!query.end)
+			continue;
+		GLuint64 begin{}, end{};
+		glGetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+		float & time = m_frameTimes[query.pass];
+		time = std::max(time, 0.f) + float(end - begin) * 1e-6f;
+		if (m_traceTrack)
+			fhl::trace::complete(m_traceTrack, m_passes[query.pass].name, std::uint64_t(std::int64_t(begin) + m_gpuToTraceTime), end - begin);
+	}
+
+	for (std::size_t i = 0u; i < m_passes.size(); ++i)
+	{
+		if (m_frameTimes[i] < 0.f)
+			continue;
+		Pass & pass = m_passes[i];
+		if (pass.history.size() < m_historyFrames)
+			pass.history.push_back(m_frameTimes[i]);
+		else
+			pass.history[pass.samples % m_historyFrames] = m_frameTimes[i];
+		++pass.samples;
+	}
+}
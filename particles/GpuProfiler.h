@@ -0,0 +1,108 @@
+#ifndef GPU_PROFILER_H
+#define GPU_PROFILER_H
+
+#include "gl/flextGL.h"
+#include "utility/Trace.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * GPU time of the passes of a frame, measured with GL_TIMESTAMP queries.
+ * Queries of the last RING_FRAMES frames are in flight; results of a frame are read when its ring slot
+ * comes around again and only if they are already available, so the CPU never waits for the GPU.
+ * A pass that runs several times in a frame (e.g. simulation substeps) is summed into one sample.
+ * Pass names must be string literals, they are compared by address.
+ * If fhl::trace is enabled when the profiler is created, passes are also added to a "GPU" trace track,
+ * with GPU timestamps moved to the trace clock by an offset measured at creation.
+ */
+class GpuProfiler
+{
+public:
+	struct PassStats
+	{
+		const char * name;
+		std::size_t samples;
+		float min; // milliseconds
+		float avg;
+		float p99;
+	};
+
+	/* _historyFrames - number of latest samples per pass that statistics are computed from */
+	explicit GpuProfiler(std::size_t _historyFrames = 240u);
+	~GpuProfiler();
+
+	GpuProfiler(const GpuProfiler &) = delete;
+	GpuProfiler & operator=(const GpuProfiler &) = delete;
+
+	void beginFrame();
+	void endFrame();
+
+	void beginPass(const char * _name);
+	void endPass();
+
+	/* reads the results of all frames in flight, waiting for the GPU if needed (for a final report) */
+	void flush();
+
+	/* passes in order of their first appearance */
+	std::vector<PassStats> getStats() const;
+	/* frames whose queries were still pending when their ring slot was needed again */
+	std::size_t getDroppedFrames() const { return m_droppedFrames; }
+	void printStats() const;
+
+	/* measures the enclosing scope as pass _name; does nothing if _profiler is nullptr */
+	class Scope
+	{
+	public:
+		Scope(GpuProfiler * _profiler, const char * _name) : m_profiler{_profiler} { if (m_profiler) m_profiler->beginPass(_name); }
+		~Scope() { if (m_profiler) m_profiler->endPass(); }
+
+		Scope(const Scope &) = delete;
+		Scope & operator=(const Scope &) = delete;
+
+	private:
+		GpuProfiler * m_profiler;
+	};
+
+private:
+	enum { RING_FRAMES = 4 };
+
+	struct PassQuery
+	{
+		std::size_t pass;
+		GLuint begin;
+		GLuint end;
+	};
+
+	struct FrameQueries
+	{
+		std::vector<GLuint> pool;
+		std::size_t used;
+		std::vector<PassQuery> passes;
+		std::vector<std::size_t> open; // indices into passes of passes not ended yet
+		bool recording;
+	};
+
+	struct Pass
+	{
+		const char * name;
+		std::vector<float> history; // ring of the last m_historyFrames samples
+		std::size_t samples;
+	};
+
+	GLuint acquireQuery(FrameQueries & _frame);
+	std::size_t findPass(const char * _name);
+	void collect(FrameQueries & _frame);
+
+	std::size_t m_historyFrames;
+	FrameQueries m_frames[RING_FRAMES];
+	std::size_t m_frame;
+	std::vector<Pass> m_passes;
+	std::vector<float> m_frameTimes; // per pass accumulator used by collect()
+	std::size_t m_droppedFrames;
+	fhl::trace::Track * m_traceTrack;
+	std::int64_t m_gpuToTraceTime;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "HeadlessContext.h"
+
+#include <cstdio>
+#if defined(FHL_USE_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
+
+HeadlessContext::HeadlessContext() :
+	m_display{nullptr},
+	m_context{nullptr}
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	destroy();
+}
+
+#if defined(FHL_USE_EGL)
+namespace
+{
+	bool hasExtension(const char * _extensions, const char * _name)
+	{
+		const std::size_t len = std::strlen(_name);
+		for (const char * p = _extensions; p && (p = std::strstr(p, _name)); p += len)
+			if ((p == _extensions || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0'))
+				return true;
+		return false;
+	}
+}
+
+bool HeadlessContext::create()
+{
+	destroy();
+
+	// surfaceless platform needs no X11/Wayland/GBM device, fall back to the default display otherwise
+	EGLDisplay display = EGL_NO_DISPLAY;
+	const char * const clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	if (display == EGL_NO_DISPLAY)
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	EGLint major{}, minor{};
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+	{
+		std::printf("Could not initialize EGL display\n");
+		return false;
+	}
+	m_display = display;
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		std::printf("EGL implementation does not support desktop OpenGL\n");
+		destroy();
+		return false;
+	}
+
+	const char * const extensions = eglQueryString(display, EGL_EXTENSIONS);
+	if (!hasExtension(extensions, "EGL_KHR_surfaceless_context"))
+	{
+		std::printf("EGL_KHR_surfaceless_context is not supported\n");
+		destroy();
+		return false;
+	}
+
+	EGLConfig config = EGL_NO_CONFIG_KHR;
+	if (!hasExtension(extensions, "EGL_KHR_no_config_context"))
+	{
+		const EGLint configAttribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+		EGLint configCount{};
+		if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || !configCount)
+		{
+			std::printf("No EGL config supporting OpenGL\n");
+			destroy();
+			return false;
+		}
+	}
+
+	const EGLint contextAttribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 5,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	m_context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+	if (m_context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+	{
+		std::printf("Could not create OpenGL 4.5 core context through EGL %d.%d\n", major, minor);
+		destroy();
+		return false;
+	}
+	return true;
+}
+
+void HeadlessContext::destroy()
+{
+	if (m_display)
+	{
+		eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_context)
+			eglDestroyContext(m_display, m_context);
+		eglTerminate(m_display);
+	}
+	m_display = m_context = nullptr;
+}
+#else
+bool HeadlessContext::create()
+{
+	std::printf("Headless mode is not available in this build (requires EGL)\n");
+	return false;
+}
+
+void HeadlessContext::destroy()
+{
+}
+#endif
@@ -0,0 +1,26 @@
+#ifndef HEADLESS_CONTEXT_H
+#define HEADLESS_CONTEXT_H
+
+/*
+ * GL 4.5 core context without a window or display server, created through EGL
+ * (surfaceless platform when available). Requires a build with FHL_USE_EGL.
+ */
+class HeadlessContext
+{
+public:
+	HeadlessContext();
+	~HeadlessContext();
+
+	HeadlessContext(const HeadlessContext &) = delete;
+	HeadlessContext & operator=(const HeadlessContext &) = delete;
+
+	/* creates the context and makes it current; prints the reason and returns false on failure */
+	bool create();
+	void destroy();
+
+private:
+	void * m_display; // EGLDisplay
+	void * m_context; // EGLContext
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef MORTON_H
+#define MORTON_H
+
+#include <cstdint>
+
+/* Morton (Z-order) codes of cells of a 1024^3 grid, 10 bits per axis interleaved with x in the lowest bit; same as morton.glsl */
+const unsigned MORTON_CELLS = 1024u;
+
+inline std::uint32_t expandMortonBits(std::uint32_t _v)
+{
+	_v = (_v * 0x00010001u) & 0xFF0000FFu;
+	_v = (_v * 0x00000101u) & 0x0F00F00Fu;
+	_v = (_v * 0x00000011u) & 0xC30C30C3u;
+	_v = (_v * 0x00000005u) & 0x49249249u;
+	return _v;
+}
+
+/* cell coordinates are clamped to the grid, NaN goes to cell 0 */
+inline std::uint32_t getMortonCode(float _x, float _y, float _z)
+{
+	const auto quantize = [](float _cell) { return std::uint32_t(_cell >= 0.f ? (_cell < 1023.f ? _cell : 1023.f) : 0.f); };
+	return expandMortonBits(quantize(_x)) | expandMortonBits(quantize(_y)) << 1 | expandMortonBits(quantize(_z)) << 2;
+}
+
+#endif
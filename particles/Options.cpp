@@ -0,0 +1,124 @@
+#include "Options.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+Options Options::parse(int _argc, char ** _argv)
+{
+	Options opts;
+	for (int i = 1; i < _argc; ++i)
+	{
+		const char * const arg = _argv[i];
+		if (!std::strcmp(arg, "--cpu"))
+			opts.cpuSimulation = true;
+		else if (!std::strcmp(arg, "--compact"))
+			opts.compactState = true;
+		else if (!std::strcmp(arg, "--render") && i + 1 < _argc)
+		{
+			const char * const path = _argv[++i];
+			if (!std::strcmp(path, "gs"))
+				opts.renderPath = RenderPath::GeometryShader;
+			else if (!std::strcmp(path, "pull"))
+				opts.renderPath = RenderPath::VertexPulling;
+			else
+				std::printf("Unknown render path: %s\n", path);
+		}
+		else if (!std::strcmp(arg, "--cull"))
+			opts.frustumCulling = true;
+		else if (!std::strcmp(arg, "--threads") && i + 1 < _argc)
+			opts.threadCount = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--cpu-kernel") && i + 1 < _argc)
+		{
+			KernelIsa isa;
+			if (!parseKernelIsa(_argv[++i], isa))
+				std::printf("Unknown CPU kernel: %s\n", _argv[i]);
+			else if (!isKernelIsaAvailable(isa))
+				std::printf("CPU kernel %s is not supported on this machine, using %s\n", _argv[i], toString(opts.kernelIsa));
+			else
+				opts.kernelIsa = isa;
+		}
+		else if (!std::strcmp(arg, "--timestep") && i + 1 < _argc)
+			opts.timestep = std::max(0.f, float(std::atof(_argv[++i])));
+		else if (!std::strcmp(arg, "--max-substeps") && i + 1 < _argc)
+			opts.maxSubsteps = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--no-interpolation"))
+			opts.interpolation = false;
+		else if (!std::strcmp(arg, "--load") && i + 1 < _argc)
+			opts.loadSnapshot = _argv[++i];
+		else if (!std::strcmp(arg, "--load-stream"))
+			opts.readSnapshot = true;
+		else if (!std::strcmp(arg, "--snapshot") && i + 1 < _argc)
+			opts.snapshotPath = _argv[++i];
+		else if (!std::strcmp(arg, "--record") && i + 1 < _argc)
+			opts.recordPath = _argv[++i];
+		else if (!std::strcmp(arg, "--record-queue") && i + 1 < _argc)
+			opts.recordQueue = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--keyframe-interval") && i + 1 < _argc)
+			opts.keyframeInterval = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--replay") && i + 1 < _argc)
+			opts.replayPath = _argv[++i];
+		else if (!std::strcmp(arg, "--headless"))
+			opts.headless = true;
+		else if (!std::strcmp(arg, "--frames") && i + 1 < _argc)
+			opts.frameCount = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--output") && i + 1 < _argc)
+			opts.outputPath = _argv[++i];
+		else if (!std::strcmp(arg, "--eager-gl"))
+			opts.eagerGl = true;
+		else if (!std::strcmp(arg, "--shader-cache") && i + 1 < _argc)
+			opts.shaderCachePath = _argv[++i];
+		else if (!std::strcmp(arg, "--no-shader-cache"))
+			opts.shaderCachePath = nullptr;
+		else if (!std::strcmp(arg, "--systems") && i + 1 < _argc)
+			opts.systemCount = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--emitters") && i + 1 < _argc)
+			opts.emitterCount = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--emit-rate") && i + 1 < _argc)
+			opts.emitRate = std::max(0.f, float(std::atof(_argv[++i])));
+		else if (!std::strcmp(arg, "--lifetime") && i + 1 < _argc)
+			opts.particleLifetime = std::max(0.f, float(std::atof(_argv[++i])));
+		else if (!std::strcmp(arg, "--force-fields") && i + 1 < _argc)
+			opts.forceFieldCount = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--kill-radius") && i + 1 < _argc)
+			opts.killRadius = std::max(0.f, float(std::atof(_argv[++i])));
+		else if (!std::strcmp(arg, "--interaction-radius") && i + 1 < _argc)
+			opts.interactionRadius = std::max(0.f, float(std::atof(_argv[++i])));
+		else if (!std::strcmp(arg, "--gravity") && i + 1 < _argc)
+		{
+			const char * const solver = _argv[++i];
+			if (!std::strcmp(solver, "none"))
+				opts.gravity = GravitySolver::None;
+			else if (!std::strcmp(solver, "bh"))
+				opts.gravity = GravitySolver::BarnesHut;
+			else if (!std::strcmp(solver, "pm"))
+				opts.gravity = GravitySolver::ParticleMesh;
+			else
+				std::printf("Unknown gravity solver: %s\n", solver);
+		}
+		else if (!std::strcmp(arg, "--opening-angle") && i + 1 < _argc)
+			opts.openingAngle = std::max(0.f, float(std::atof(_argv[++i])));
+		else if (!std::strcmp(arg, "--pm-grid") && i + 1 < _argc)
+		{
+			const unsigned size = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+			if (size >= 8u && size <= 256u && !(size & (size - 1u)))
+				opts.meshSize = size;
+			else
+				std::printf("Particle-mesh grid size must be a power of two from 8 to 256: %s\n", _argv[i]);
+		}
+		else if (!std::strcmp(arg, "--compact-interval") && i + 1 < _argc)
+			opts.compactInterval = unsigned(std::strtoul(_argv[++i], nullptr, 10));
+		else if (!std::strcmp(arg, "--morton-order"))
+			opts.mortonOrder = true;
+		else if (!std::strcmp(arg, "--gpu-profile"))
+			opts.gpuProfile = true;
+		else if (!std::strcmp(arg, "--trace") && i + 1 < _argc)
+			opts.tracePath = _argv[++i];
+		else if (!std::strcmp(arg, "--no-shader-reload"))
+			opts.shaderReload = false;
+		else
+			std::printf("Unknown option: %s\n", arg);
+	}
+	return opts;
+}
@@ -0,0 +1,62 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include "ParticleKernels.h"
+
+enum class RenderPath
+{
+	GeometryShader, // points expanded to quads by particle.geom
+	VertexPulling   // 6 vertices per particle reading the state buffers, no geometry shader
+};
+
+enum class GravitySolver
+{
+	None,
+	BarnesHut, // octree of the particles rebuilt every step, far groups act as their centre of mass
+	ParticleMesh // mass deposited on a periodic grid, potential solved by FFT
+};
+
+/* Startup configuration read from the command line */
+struct Options
+{
+	bool cpuSimulation = false; // --cpu: run simulate.comp step on the CPU and upload results
+	unsigned threadCount = 0u; // --threads N: CPU simulation threads, 0 - hardware concurrency
+	bool compactState = false; // --compact: float3 positions and half-float velocities in GL buffers
+	RenderPath renderPath = RenderPath::GeometryShader; // --render gs|pull
+	bool frustumCulling = false; // --cull: GPU frustum culling with indirect draw of visible particles
+	KernelIsa kernelIsa = detectBestKernelIsa(); // --cpu-kernel scalar|sse|avx2|avx512
+	float timestep = 1.f / 60.f; // --timestep S: fixed simulation step in seconds, 0 - one step of frame time per frame
+	unsigned maxSubsteps = 4u; // --max-substeps N: fixed steps run at most per frame
+	bool interpolation = true; // --no-interpolation: draw last simulated state instead of blending the last two
+	const char * loadSnapshot = nullptr; // --load PATH: start from a snapshot instead of the grid
+	bool readSnapshot = false; // --load-stream: read the whole snapshot into memory with file reads instead of mapping it
+	const char * snapshotPath = "particles.snap"; // --snapshot PATH: file written when F5 is pressed
+	const char * recordPath = nullptr; // --record PATH: write every simulation step to a recording
+	unsigned recordQueue = 4u; // --record-queue N: frames buffered for the recording thread before dropping, and GPU staging copies in flight
+	unsigned keyframeInterval = 30u; // --keyframe-interval N: recorded frames between full (non-delta) frames
+	const char * replayPath = nullptr; // --replay PATH: play a recording back instead of simulating
+	bool headless = false; // --headless: render to an offscreen framebuffer of an EGL context, no window
+	unsigned frameCount = 0u; // --frames N: exit after N frames, 0 - when the window is closed (1000 frames headless)
+	const char * outputPath = nullptr; // --output PATH: save the last frame as binary PPM
+	const char * shaderCachePath = "shader_cache"; // --shader-cache DIR, --no-shader-cache: directory of linked program binaries
+	bool shaderReload = true; // --no-shader-reload: don't watch res/shaders for changes
+	unsigned systemCount = 1u; // --systems N: particle systems the particles are split into, simulated and drawn in one batch
+	unsigned emitterCount = 0u; // --emitters N: emitters around the grid (GPU simulation only), each spawning into its own particle system
+	float emitRate = 16384.f; // --emit-rate R: particles spawned per second by each emitter
+	float particleLifetime = 4.f; // --lifetime S: seconds an emitted particle lives
+	unsigned forceFieldCount = 0u; // --force-fields N: point, vortex, wind and turbulence fields around the grid, cycling through the types
+	float killRadius = 0.f; // --kill-radius R: particles farther than R from the middle of the grid are removed by compaction, 0 keeps them
+	float interactionRadius = 0.f; // --interaction-radius H: particles closer than H repel and attract each other, 0 disables it
+	GravitySolver gravity = GravitySolver::None; // --gravity none|bh|pm: gravity between all particles
+	float openingAngle = .5f; // --opening-angle A: Barnes-Hut nodes smaller than A times their distance are not opened
+	unsigned meshSize = 128u; // --pm-grid N: particle-mesh cells per axis, a power of two from 8 to 256
+	unsigned compactInterval = 60u; // --compact-interval N: simulation steps between compactions of dead and removed particles
+	bool mortonOrder = false; // --morton-order: compactions also sort the particles of each system along a Z-order curve
+	bool gpuProfile = false; // --gpu-profile: measure GPU time of frame passes with timestamp queries
+	const char * tracePath = nullptr; // --trace PATH: Chrome trace JSON of CPU threads and GPU passes, written at exit and on F7
+	bool eagerGl = false; // --eager-gl: resolve all GL entry points at startup instead of on first call
+
+	static Options parse(int _argc, char ** _argv);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PARTICLE_EMITTER_H
+#define PARTICLE_EMITTER_H
+
+#include "maths/vectors.h"
+
+#include <cstddef>
+
+/*
+ * Spawns particles of one particle system at a point, rate per second, in random directions at speed,
+ * living for lifetime seconds. Spawns are taken from the dead particles of the system by ParticleSpawner::spawn().
+ */
+class ParticleEmitter
+{
+public:
+	ParticleEmitter(std::size_t _system, const fhl::Vec3f & _position, float _rate, float _speed, float _lifetime) :
+		m_system{_system}, m_position{_position}, m_rate{_rate}, m_speed{_speed}, m_lifetime{_lifetime}, m_pending{0.f} {}
+
+	/* index of the system in its ParticleSystemManager */
+	std::size_t getSystem() const { return m_system; }
+
+	const fhl::Vec3f & getPosition() const { return m_position; }
+	void setPosition(const fhl::Vec3f & _position) { m_position = _position; }
+
+	float getRate() const { return m_rate; }
+	void setRate(float _rate) { m_rate = _rate; }
+
+	float getSpeed() const { return m_speed; }
+	void setSpeed(float _speed) { m_speed = _speed; }
+
+	float getLifetime() const { return m_lifetime; }
+	void setLifetime(float _lifetime) { m_lifetime = _lifetime; }
+
+private:
+	friend class ParticleSpawner;
+
+	std::size_t m_system;
+	fhl::Vec3f m_position;
+	float m_rate;
+	float m_speed;
+	float m_lifetime;
+	float m_pending; // fraction of a particle carried over to the next step
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include "ParticleKernels.h"
+#include "SimulationConstants.h"
+#include "utility/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace kernels
+{
+
+	namespace
+	{
+		template<bool Attractor>
+		void updateScalarImpl(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+		{
+			const float dt = _params.dt;
+			const float damping = 1.f - constants::DAMPING * dt;
+			const float ax = _params.attractorPosition[0], ay = _params.attractorPosition[1], az = _params.attractorPosition[2];
+
+			for (std::size_t i = _begin; i < _end; ++i)
+			{
+				float vx = _s.vx[i] * damping, vy = _s.vy[i] * damping, vz = _s.vz[i] * damping;
+				if (Attractor)
+				{
+					const float dx = ax - _s.px[i], dy = ay - _s.py[i], dz = az - _s.pz[i];
+					const float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+					const float acc = constants::ATTRACTOR_ACCELERATION * _params.attractorScale / std::max(1.f, constants::ATTRACTOR_FALLOFF * std::pow(dist, 1.5f));
+					const float scale = acc * dt / dist;
+					vx += dx * scale;
+					vy += dy * scale;
+					vz += dz * scale;
+				}
+				_s.vx[i] = vx;
+				_s.vy[i] = vy;
+				_s.vz[i] = vz;
+				_s.px[i] += vx * dt;
+				_s.py[i] += vy * dt;
+				_s.pz[i] += vz * dt;
+			}
+		}
+	}
+
+	void updateScalar(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		if (_params.attractorActive)
+			updateScalarImpl<true>(_s, _params, _begin, _end);
+		else
+			updateScalarImpl<false>(_s, _params, _begin, _end);
+	}
+
+	void applyForceFields(const ParticleStreams & _s, const SimulationParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		const float dt = _params.dt;
+		for (std::size_t f = 0u; f < _params.forceFieldCount; ++f)
+		{
+			const ForceField & field = _params.forceFields[f];
+			const float cx = field.position.x(), cy = field.position.y(), cz = field.position.z();
+			const float ax = field.direction.x(), ay = field.direction.y(), az = field.direction.z();
+			const float invRadiusSq = 1.f / (field.radius * field.radius);
+			switch (field.type)
+			{
+			case ForceField::Type::Point:
+				for (std::size_t i = _begin; i < _end; ++i)
+				{
+					const float rx = _s.px[i] - cx, ry = _s.py[i] - cy, rz = _s.pz[i] - cz;
+					const float distSq = rx * rx + ry * ry + rz * rz;
+					const float dist = std::sqrt(distSq);
+					const float scale = -field.strength / (1.f + distSq * invRadiusSq) / std::max(dist, constants::FORCE_FIELD_MIN_DISTANCE) * dt;
+					_s.vx[i] += rx * scale;
+					_s.vy[i] += ry * scale;
+					_s.vz[i] += rz * scale;
+				}
+				break;
+			case ForceField::Type::Vortex:
+				for (std::size_t i = _begin; i < _end; ++i)
+				{
+					const float rx = _s.px[i] - cx, ry = _s.py[i] - cy, rz = _s.pz[i] - cz;
+					const float along = rx * ax + ry * ay + rz * az;
+					const float qx = rx - ax * along, qy = ry - ay * along, qz = rz - az * along;
+					const float distSq = qx * qx + qy * qy + qz * qz;
+					const float dist = std::sqrt(distSq);
+					const float scale = field.strength / (1.f + distSq * invRadiusSq) / std::max(dist, constants::FORCE_FIELD_MIN_DISTANCE) * dt;
+					_s.vx[i] += (ay * qz - az * qy) * scale;
+					_s.vy[i] += (az * qx - ax * qz) * scale;
+					_s.vz[i] += (ax * qy - ay * qx) * scale;
+				}
+				break;
+			case ForceField::Type::Wind:
+				for (std::size_t i = _begin; i < _end; ++i)
+				{
+					_s.vx[i] += ax * field.strength * dt;
+					_s.vy[i] += ay * field.strength * dt;
+					_s.vz[i] += az * field.strength * dt;
+				}
+				break;
+			case ForceField::Type::Turbulence:
+				for (std::size_t i = _begin; i < _end; ++i)
+				{
+					const float qx = (_s.px[i] - cx) / field.radius + field.phase;
+					const float qy = (_s.py[i] - cy) / field.radius + field.phase;
+					const float qz = (_s.pz[i] - cz) / field.radius + field.phase;
+					const float scale = field.strength * dt;
+					_s.vx[i] += std::sin(qy) * std::cos(qz) * scale;
+					_s.vy[i] += std::sin(qz) * std::cos(qx) * scale;
+					_s.vz[i] += std::sin(qx) * std::cos(qy) * scale;
+				}
+				break;
+			}
+		}
+	}
+
+}
+
+UpdateParams makeUpdateParams(const SimulationParams & _params, float _attractorScale)
+{
+	const fhl::Vec3f & attractor = _params.attractorPosition;
+	return UpdateParams{_params.dt, _params.attractorActive, {attractor.x(), attractor.y(), attractor.z()}, _attractorScale};
+}
+
+bool isKernelIsaAvailable(KernelIsa _isa)
+{
+	const fhl::CpuFeatures & cpu = fhl::CpuFeatures::get();
+	switch (_isa)
+	{
+	case KernelIsa::Scalar: return true;
+	case KernelIsa::Sse: return kernels::sseCompiled && cpu.sse2;
+	case KernelIsa::Avx2: return kernels::avx2Compiled && cpu.avx2 && cpu.fma;
+	case KernelIsa::Avx512: return kernels::avx512Compiled && cpu.avx512f;
+	}
+	return false;
+}
+
+KernelIsa detectBestKernelIsa()
+{
+	for (KernelIsa isa : {KernelIsa::Avx512, KernelIsa::Avx2, KernelIsa::Sse})
+		if (isKernelIsaAvailable(isa))
+			return isa;
+	return KernelIsa::Scalar;
+}
+
+UpdateKernel getUpdateKernel(KernelIsa _isa)
+{
+	switch (_isa)
+	{
+	case KernelIsa::Sse: return &kernels::updateSse;
+	case KernelIsa::Avx2: return &kernels::updateAvx2;
+	case KernelIsa::Avx512: return &kernels::updateAvx512;
+	default: return &kernels::updateScalar;
+	}
+}
+
+const char * toString(KernelIsa _isa)
+{
+	switch (_isa)
+	{
+	case KernelIsa::Sse: return "sse";
+	case KernelIsa::Avx2: return "avx2";
+	case KernelIsa::Avx512: return "avx512";
+	default: return "scalar";
+	}
+}
+
+bool parseKernelIsa(const char * _str, KernelIsa & _isa)
+{
+	for (KernelIsa isa : {KernelIsa::Scalar, KernelIsa::Sse, KernelIsa::Avx2, KernelIsa::Avx512})
+	{
+		if (!std::strcmp(_str, toString(isa)))
+		{
+			_isa = isa;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,30 @@
+#ifndef PARTICLE_KERNELS_H
+#define PARTICLE_KERNELS_H
+
+#include "ParticleSimulator.h"
+#include "ParticleStorage.h"
+#include "UpdateKernels.h"
+
+#include <cstddef>
+
+/* CPU versions of the simulate.comp step over [_begin, _end) of SoA streams, one per instruction set (see UpdateKernels.h) */
+enum class KernelIsa { Scalar, Sse, Avx2, Avx512 };
+
+namespace kernels
+{
+	/* adds the accelerations of _params.forceFields times _params.dt to the velocities of [_begin, _end) as force_fields.glsl,
+	   one field over all particles at a time; run before the update kernel, which damps them */
+	void applyForceFields(const ParticleStreams & _streams, const SimulationParams & _params, std::size_t _begin, std::size_t _end);
+}
+
+/* the parameters of the update kernels for a system range with _attractorScale */
+UpdateParams makeUpdateParams(const SimulationParams & _params, float _attractorScale);
+
+bool isKernelIsaAvailable(KernelIsa _isa);
+KernelIsa detectBestKernelIsa();
+UpdateKernel getUpdateKernel(KernelIsa _isa);
+
+const char * toString(KernelIsa _isa);
+bool parseKernelIsa(const char * _str, KernelIsa & _isa);
+
+#endif
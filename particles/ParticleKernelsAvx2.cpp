@@ -0,0 +1,77 @@
+#include "SimulationConstants.h"
+#include "UpdateKernels.h"
+
+#if (defined(__AVX2__) && defined(__FMA__)) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <immintrin.h>
+
+namespace kernels
+{
+
+	const bool avx2Compiled = true;
+
+	namespace
+	{
+		template<bool Attractor>
+		void updateAvx2Impl(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+		{
+			const __m256 dt = _mm256_set1_ps(_params.dt);
+			const __m256 damping = _mm256_set1_ps(1.f - constants::DAMPING * _params.dt);
+			const __m256 ax = _mm256_set1_ps(_params.attractorPosition[0]);
+			const __m256 ay = _mm256_set1_ps(_params.attractorPosition[1]);
+			const __m256 az = _mm256_set1_ps(_params.attractorPosition[2]);
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 distScale = _mm256_set1_ps(constants::ATTRACTOR_FALLOFF);
+			const __m256 accDt = _mm256_set1_ps(constants::ATTRACTOR_ACCELERATION * _params.attractorScale * _params.dt);
+
+			std::size_t i = _begin;
+			for (; i + 8u <= _end; i += 8u)
+			{
+				__m256 px = _mm256_loadu_ps(_s.px + i), py = _mm256_loadu_ps(_s.py + i), pz = _mm256_loadu_ps(_s.pz + i);
+				__m256 vx = _mm256_mul_ps(_mm256_loadu_ps(_s.vx + i), damping);
+				__m256 vy = _mm256_mul_ps(_mm256_loadu_ps(_s.vy + i), damping);
+				__m256 vz = _mm256_mul_ps(_mm256_loadu_ps(_s.vz + i), damping);
+				if (Attractor)
+				{
+					const __m256 dx = _mm256_sub_ps(ax, px), dy = _mm256_sub_ps(ay, py), dz = _mm256_sub_ps(az, pz);
+					const __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+					// pow(dist, 1.5) == dist * sqrt(dist)
+					const __m256 denom = _mm256_max_ps(one, _mm256_mul_ps(distScale, _mm256_mul_ps(dist, _mm256_sqrt_ps(dist))));
+					const __m256 scale = _mm256_div_ps(_mm256_div_ps(accDt, denom), dist);
+					vx = _mm256_fmadd_ps(dx, scale, vx);
+					vy = _mm256_fmadd_ps(dy, scale, vy);
+					vz = _mm256_fmadd_ps(dz, scale, vz);
+				}
+				_mm256_storeu_ps(_s.vx + i, vx);
+				_mm256_storeu_ps(_s.vy + i, vy);
+				_mm256_storeu_ps(_s.vz + i, vz);
+				_mm256_storeu_ps(_s.px + i, _mm256_fmadd_ps(vx, dt, px));
+				_mm256_storeu_ps(_s.py + i, _mm256_fmadd_ps(vy, dt, py));
+				_mm256_storeu_ps(_s.pz + i, _mm256_fmadd_ps(vz, dt, pz));
+			}
+			if (i < _end)
+				updateScalar(_s, _params, i, _end);
+		}
+	}
+
+	void updateAvx2(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		if (_params.attractorActive)
+			updateAvx2Impl<true>(_s, _params, _begin, _end);
+		else
+			updateAvx2Impl<false>(_s, _params, _begin, _end);
+	}
+
+}
+#else
+namespace kernels
+{
+
+	const bool avx2Compiled = false;
+
+	void updateAvx2(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		updateScalar(_s, _params, _begin, _end);
+	}
+
+}
+#endif
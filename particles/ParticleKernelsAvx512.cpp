@@ -0,0 +1,77 @@
+#include "SimulationConstants.h"
+#include "UpdateKernels.h"
+
+#if defined(__AVX512F__) || (defined(_MSC_VER) && _MSC_VER >= 1911 && defined(_M_X64))
+#include <immintrin.h>
+
+namespace kernels
+{
+
+	const bool avx512Compiled = true;
+
+	namespace
+	{
+		template<bool Attractor>
+		void updateAvx512Impl(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+		{
+			const __m512 dt = _mm512_set1_ps(_params.dt);
+			const __m512 damping = _mm512_set1_ps(1.f - constants::DAMPING * _params.dt);
+			const __m512 ax = _mm512_set1_ps(_params.attractorPosition[0]);
+			const __m512 ay = _mm512_set1_ps(_params.attractorPosition[1]);
+			const __m512 az = _mm512_set1_ps(_params.attractorPosition[2]);
+			const __m512 one = _mm512_set1_ps(1.f);
+			const __m512 distScale = _mm512_set1_ps(constants::ATTRACTOR_FALLOFF);
+			const __m512 accDt = _mm512_set1_ps(constants::ATTRACTOR_ACCELERATION * _params.attractorScale * _params.dt);
+
+			std::size_t i = _begin;
+			for (; i + 16u <= _end; i += 16u)
+			{
+				__m512 px = _mm512_loadu_ps(_s.px + i), py = _mm512_loadu_ps(_s.py + i), pz = _mm512_loadu_ps(_s.pz + i);
+				__m512 vx = _mm512_mul_ps(_mm512_loadu_ps(_s.vx + i), damping);
+				__m512 vy = _mm512_mul_ps(_mm512_loadu_ps(_s.vy + i), damping);
+				__m512 vz = _mm512_mul_ps(_mm512_loadu_ps(_s.vz + i), damping);
+				if (Attractor)
+				{
+					const __m512 dx = _mm512_sub_ps(ax, px), dy = _mm512_sub_ps(ay, py), dz = _mm512_sub_ps(az, pz);
+					const __m512 dist = _mm512_sqrt_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)), _mm512_mul_ps(dz, dz)));
+					// pow(dist, 1.5) == dist * sqrt(dist)
+					const __m512 denom = _mm512_max_ps(one, _mm512_mul_ps(distScale, _mm512_mul_ps(dist, _mm512_sqrt_ps(dist))));
+					const __m512 scale = _mm512_div_ps(_mm512_div_ps(accDt, denom), dist);
+					vx = _mm512_fmadd_ps(dx, scale, vx);
+					vy = _mm512_fmadd_ps(dy, scale, vy);
+					vz = _mm512_fmadd_ps(dz, scale, vz);
+				}
+				_mm512_storeu_ps(_s.vx + i, vx);
+				_mm512_storeu_ps(_s.vy + i, vy);
+				_mm512_storeu_ps(_s.vz + i, vz);
+				_mm512_storeu_ps(_s.px + i, _mm512_fmadd_ps(vx, dt, px));
+				_mm512_storeu_ps(_s.py + i, _mm512_fmadd_ps(vy, dt, py));
+				_mm512_storeu_ps(_s.pz + i, _mm512_fmadd_ps(vz, dt, pz));
+			}
+			if (i < _end)
+				updateScalar(_s, _params, i, _end);
+		}
+	}
+
+	void updateAvx512(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		if (_params.attractorActive)
+			updateAvx512Impl<true>(_s, _params, _begin, _end);
+		else
+			updateAvx512Impl<false>(_s, _params, _begin, _end);
+	}
+
+}
+#else
+namespace kernels
+{
+
+	const bool avx512Compiled = false;
+
+	void updateAvx512(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		updateScalar(_s, _params, _begin, _end);
+	}
+
+}
+#endif
@@ -0,0 +1,77 @@
+#include "SimulationConstants.h"
+#include "UpdateKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+namespace kernels
+{
+
+	const bool sseCompiled = true;
+
+	namespace
+	{
+		template<bool Attractor>
+		void updateSseImpl(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+		{
+			const __m128 dt = _mm_set1_ps(_params.dt);
+			const __m128 damping = _mm_set1_ps(1.f - constants::DAMPING * _params.dt);
+			const __m128 ax = _mm_set1_ps(_params.attractorPosition[0]);
+			const __m128 ay = _mm_set1_ps(_params.attractorPosition[1]);
+			const __m128 az = _mm_set1_ps(_params.attractorPosition[2]);
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 distScale = _mm_set1_ps(constants::ATTRACTOR_FALLOFF);
+			const __m128 accDt = _mm_set1_ps(constants::ATTRACTOR_ACCELERATION * _params.attractorScale * _params.dt);
+
+			std::size_t i = _begin;
+			for (; i + 4u <= _end; i += 4u)
+			{
+				__m128 px = _mm_loadu_ps(_s.px + i), py = _mm_loadu_ps(_s.py + i), pz = _mm_loadu_ps(_s.pz + i);
+				__m128 vx = _mm_mul_ps(_mm_loadu_ps(_s.vx + i), damping);
+				__m128 vy = _mm_mul_ps(_mm_loadu_ps(_s.vy + i), damping);
+				__m128 vz = _mm_mul_ps(_mm_loadu_ps(_s.vz + i), damping);
+				if (Attractor)
+				{
+					const __m128 dx = _mm_sub_ps(ax, px), dy = _mm_sub_ps(ay, py), dz = _mm_sub_ps(az, pz);
+					const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+					// pow(dist, 1.5) == dist * sqrt(dist)
+					const __m128 denom = _mm_max_ps(one, _mm_mul_ps(distScale, _mm_mul_ps(dist, _mm_sqrt_ps(dist))));
+					const __m128 scale = _mm_div_ps(_mm_div_ps(accDt, denom), dist);
+					vx = _mm_add_ps(vx, _mm_mul_ps(dx, scale));
+					vy = _mm_add_ps(vy, _mm_mul_ps(dy, scale));
+					vz = _mm_add_ps(vz, _mm_mul_ps(dz, scale));
+				}
+				_mm_storeu_ps(_s.vx + i, vx);
+				_mm_storeu_ps(_s.vy + i, vy);
+				_mm_storeu_ps(_s.vz + i, vz);
+				_mm_storeu_ps(_s.px + i, _mm_add_ps(px, _mm_mul_ps(vx, dt)));
+				_mm_storeu_ps(_s.py + i, _mm_add_ps(py, _mm_mul_ps(vy, dt)));
+				_mm_storeu_ps(_s.pz + i, _mm_add_ps(pz, _mm_mul_ps(vz, dt)));
+			}
+			if (i < _end)
+				updateScalar(_s, _params, i, _end);
+		}
+	}
+
+	void updateSse(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		if (_params.attractorActive)
+			updateSseImpl<true>(_s, _params, _begin, _end);
+		else
+			updateSseImpl<false>(_s, _params, _begin, _end);
+	}
+
+}
+#else
+namespace kernels
+{
+
+	const bool sseCompiled = false;
+
+	void updateSse(const ParticleStreams & _s, const UpdateParams & _params, std::size_t _begin, std::size_t _end)
+	{
+		updateScalar(_s, _params, _begin, _end);
+	}
+
+}
+#endif
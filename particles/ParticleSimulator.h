@@ -0,0 +1,28 @@
+#ifndef PARTICLE_SIMULATOR_H
+#define PARTICLE_SIMULATOR_H
+
+#include "ForceField.h"
+#include "maths/vectors.h"
+
+#include <cstddef>
+
+struct SimulationParams
+{
+	float dt;
+	bool attractorActive;
+	fhl::Vec3f attractorPosition;
+	const ForceField * forceFields = nullptr; // applied to the particles of all systems
+	std::size_t forceFieldCount = 0u;
+};
+
+/* Common interface of simulate.comp step implementations (GL compute shader or CPU) */
+class ParticleSimulator
+{
+public:
+	virtual ~ParticleSimulator() = default;
+
+	virtual void update(const SimulationParams & _params) = 0;
+	virtual std::size_t getParticleCount() const = 0;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "ParticleSpawner.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	enum UniformBlockBinding { EmitterParamsBlock = 3 };
+
+	// std140 Emitter struct of emitters.glsl
+	struct EmitterData
+	{
+		float position[3];
+		float speed;
+		float lifetime;
+		std::uint32_t system;
+		std::uint32_t requested;
+		float padding;
+	};
+
+	// std140 EmitterParams block of emitters.glsl, MAX_EMITTERS is ParticleSpawner::MaxEmitters
+	struct EmitterUniforms
+	{
+		std::uint32_t emitterCount;
+		std::uint32_t seed;
+		std::uint32_t padding[2];
+		EmitterData emitters[ParticleSpawner::MaxEmitters];
+	};
+	static_assert(sizeof(EmitterUniforms) == 16 + 32 * ParticleSpawner::MaxEmitters, "EmitterUniforms must match the std140 layout of EmitterParams");
+}
+
+ParticleSpawner::ParticleSpawner(GLuint _prepareProgram, GLuint _emitProgram, ParticleSystemManager & _systems, UniformRing & _uniforms) :
+	m_prepareProgram{_prepareProgram},
+	m_emitProgram{_emitProgram},
+	m_systems(_systems),
+	m_uniforms(_uniforms),
+	m_step{0u},
+	m_lifeBuffer{},
+	m_deadCountBuffer{},
+	m_deadIndexBuffer{},
+	m_spawnBuffer{}
+{
+	const float immortal = std::numeric_limits<float>::infinity();
+	glCreateBuffers(1, &m_lifeBuffer);
+	glNamedBufferStorage(m_lifeBuffer, m_systems.getCapacity() * sizeof(float), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	glClearNamedBufferData(m_lifeBuffer, GL_R32F, GL_RED, GL_FLOAT, &immortal);
+
+	const GLuint zero = 0u;
+	glCreateBuffers(1, &m_deadCountBuffer);
+	glNamedBufferStorage(m_deadCountBuffer, m_systems.getMaxSystems() * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	glClearNamedBufferData(m_deadCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+	glCreateBuffers(1, &m_deadIndexBuffer);
+	glNamedBufferStorage(m_deadIndexBuffer, m_systems.getCapacity() * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	// dispatch arguments and spawn total, then one uvec4 per emitter
+	glCreateBuffers(1, &m_spawnBuffer);
+	glNamedBufferStorage(m_spawnBuffer, (1u + MaxEmitters) * 4u * sizeof(GLuint), nullptr, 0);
+}
+
+ParticleSpawner::~ParticleSpawner()
+{
+	glDeleteBuffers(1, &m_lifeBuffer);
+	glDeleteBuffers(1, &m_deadCountBuffer);
+	glDeleteBuffers(1, &m_deadIndexBuffer);
+	glDeleteBuffers(1, &m_spawnBuffer);
+}
+
+ParticleEmitter * ParticleSpawner::addEmitter(std::size_t _system, const fhl::Vec3f & _position, float _rate, float _speed, float _lifetime)
+{
+	if (m_emitters.size() == MaxEmitters)
+		return nullptr;
+	if (m_emissive.size() <= _system)
+		m_emissive.resize(_system + 1u, false);
+	if (!m_emissive[_system])
+	{ // whole system dead, stacked so that spawns start at its first particle
+		ParticleSystem & system = m_systems.getSystem(_system);
+		system.setCount(0u);
+		std::vector<GLuint> dead(system.getCapacity());
+		for (std::size_t i = 0u; i < dead.size(); ++i)
+			dead[i] = GLuint(system.getFirst() + dead.size() - 1u - i);
+		const float lifeZero = 0.f;
+		const GLuint count = GLuint(dead.size());
+		glClearNamedBufferSubData(m_lifeBuffer, GL_R32F, system.getFirst() * sizeof(float), dead.size() * sizeof(float), GL_RED, GL_FLOAT, &lifeZero);
+		glNamedBufferSubData(m_deadIndexBuffer, system.getFirst() * sizeof(GLuint), dead.size() * sizeof(GLuint), dead.data());
+		glNamedBufferSubData(m_deadCountBuffer, _system * sizeof(GLuint), sizeof(GLuint), &count);
+		m_emissive[_system] = true;
+	}
+	m_emitters.emplace_back(new ParticleEmitter{_system, _position, _rate, _speed, _lifetime});
+	return m_emitters.back().get();
+}
+
+void ParticleSpawner::spawn(float _dt)
+{
+	if (m_emitters.empty())
+		return;
+
+	EmitterUniforms uniforms;
+	uniforms.emitterCount = std::uint32_t(m_emitters.size());
+	uniforms.seed = m_step++;
+	uniforms.padding[0] = uniforms.padding[1] = 0u;
+	for (std::size_t i = 0u; i < m_emitters.size(); ++i)
+	{
+		ParticleEmitter & emitter = *m_emitters[i];
+		// whole particles only, the rest is emitted in later steps
+		emitter.m_pending += emitter.m_rate * _dt;
+		const float requested = std::floor(emitter.m_pending);
+		emitter.m_pending -= requested;
+
+		const float capacity = float(m_systems.getSystem(emitter.m_system).getCapacity());
+		const fhl::Vec3f & pos = emitter.m_position;
+		uniforms.emitters[i] = EmitterData{{pos.x(), pos.y(), pos.z()}, emitter.m_speed, emitter.m_lifetime,
+			std::uint32_t(emitter.m_system), std::uint32_t(requested < capacity ? requested : capacity), 0.f};
+	}
+	m_uniforms.push(UniformBlockBinding::EmitterParamsBlock, uniforms);
+
+	glUseProgram(m_prepareProgram);
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+	glUseProgram(m_emitProgram);
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_spawnBuffer);
+	glDispatchComputeIndirect(0);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+void ParticleSpawner::bind() const
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::LifeBuffer, m_lifeBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::DeadCountBuffer, m_deadCountBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::DeadIndexBuffer, m_deadIndexBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::SpawnBuffer, m_spawnBuffer);
+}
+
+UniformUsage ParticleSpawner::getUniformUsage()
+{
+	return UniformUsage{1u, sizeof(EmitterUniforms)};
+}
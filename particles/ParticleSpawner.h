@@ -0,0 +1,68 @@
+#ifndef PARTICLE_SPAWNER_H
+#define PARTICLE_SPAWNER_H
+
+#include "gl/flextGL.h"
+#include "ParticleEmitter.h"
+#include "ParticleSystemManager.h"
+#include "UniformRing.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * Particle lifetimes and emitters, entirely on the GPU (simulate.comp, emit_prepare.comp and emit.comp compiled with LIFETIME).
+ * Systems with an emitter start with all particles dead and their indices on the system's dead stack (SSBO bindings 8 and 9),
+ * with none in use; particles of other systems never die. simulate.comp counts lifetimes (SSBO binding 7) down and pushes expiring particles,
+ * spawn() has emit_prepare.comp clamp the requests of the step to the stacks and pop them, and emit.comp initialize the popped
+ * particles in an indirect dispatch sized by emit_prepare.comp, so no counts are ever read back. Stacks are popped from
+ * the start of the range, which grows the system's count up to the most particles alive at once; GlParticleCompactor shrinks it.
+ * Must be created with the GL context current.
+ */
+class ParticleSpawner
+{
+public:
+	enum { MaxEmitters = 64 };
+	enum Bindings { LifeBuffer = 7, DeadCountBuffer = 8, DeadIndexBuffer = 9, SpawnBuffer = 10 };
+
+	/* _prepareProgram - emit_prepare.comp, _emitProgram - emit.comp; the caller keeps ownership */
+	ParticleSpawner(GLuint _prepareProgram, GLuint _emitProgram, ParticleSystemManager & _systems, UniformRing & _uniforms);
+	~ParticleSpawner();
+
+	ParticleSpawner(const ParticleSpawner &) = delete;
+	ParticleSpawner & operator=(const ParticleSpawner &) = delete;
+
+	/* the first emitter of a system kills all of its particles; nullptr if there are MaxEmitters already */
+	ParticleEmitter * addEmitter(std::size_t _system, const fhl::Vec3f & _position, float _rate, float _speed, float _lifetime);
+	std::size_t getEmitterCount() const { return m_emitters.size(); }
+	ParticleEmitter & getEmitter(std::size_t _idx) { return *m_emitters[_idx]; }
+
+	/* spawns the particles emitted during _dt, after the simulation step */
+	void spawn(float _dt);
+	/* uniform blocks a spawn() pushes */
+	static UniformUsage getUniformUsage();
+	void bind() const;
+
+	/* float remaining lifetime per particle, for vertex fetch */
+	GLuint getLifeBuffer() const { return m_lifeBuffer; }
+
+	/* takes relinked programs, the caller keeps ownership */
+	void setPrograms(GLuint _prepareProgram, GLuint _emitProgram) { m_prepareProgram = _prepareProgram; m_emitProgram = _emitProgram; }
+
+private:
+	GLuint m_prepareProgram;
+	GLuint m_emitProgram;
+	ParticleSystemManager & m_systems;
+	UniformRing & m_uniforms;
+	std::vector<std::unique_ptr<ParticleEmitter>> m_emitters;
+	std::vector<bool> m_emissive; // per system, has a dead stack
+	std::uint32_t m_step;
+
+	GLuint m_lifeBuffer;
+	GLuint m_deadCountBuffer;
+	GLuint m_deadIndexBuffer;
+	GLuint m_spawnBuffer;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "ParticleStorage.h"
+#include "maths/Half.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace
+{
+	void * alignedAlloc(std::size_t _size, std::size_t _alignment)
+	{
+#if defined(_MSC_VER)
+		void * ptr = _aligned_malloc(_size, _alignment);
+#else
+		void * ptr = nullptr;
+		if (posix_memalign(&ptr, _alignment, _size))
+			ptr = nullptr;
+#endif
+		if (!ptr)
+			throw std::bad_alloc();
+		return ptr;
+	}
+
+	void alignedFree(void * _ptr)
+	{
+#if defined(_MSC_VER)
+		_aligned_free(_ptr);
+#else
+		std::free(_ptr);
+#endif
+	}
+}
+
+ParticleStorage::ParticleStorage(std::size_t _count) :
+	m_count{_count},
+	m_data{nullptr},
+	m_streams{}
+{
+	if (!m_count)
+		return;
+
+	const std::size_t stride = (m_count + LaneMultiple - 1u) / LaneMultiple * LaneMultiple;
+	m_data = static_cast<float *>(alignedAlloc(6u * stride * sizeof(float), Alignment));
+	std::memset(m_data, 0, 6u * stride * sizeof(float));
+
+	float * streams[6];
+	for (std::size_t i = 0u; i < 6u; ++i)
+		streams[i] = m_data + i * stride;
+	m_streams = ParticleStreams{streams[0], streams[1], streams[2], streams[3], streams[4], streams[5]};
+}
+
+ParticleStorage::ParticleStorage(ParticleStorage && _other) noexcept :
+	m_count{_other.m_count},
+	m_data{_other.m_data},
+	m_streams{_other.m_streams}
+{
+	_other.m_count = 0u;
+	_other.m_data = nullptr;
+	_other.m_streams = ParticleStreams{};
+}
+
+ParticleStorage & ParticleStorage::operator=(ParticleStorage && _other) noexcept
+{
+	std::swap(m_count, _other.m_count);
+	std::swap(m_data, _other.m_data);
+	std::swap(m_streams, _other.m_streams);
+	return *this;
+}
+
+ParticleStorage::~ParticleStorage()
+{
+	if (m_data)
+		alignedFree(m_data);
+}
+
+void ParticleStorage::set(std::size_t _idx, const fhl::Vec3f & _position, const fhl::Vec3f & _velocity)
+{
+	const ParticleStreams & s = m_streams;
+	s.px[_idx] = _position.x();
+	s.py[_idx] = _position.y();
+	s.pz[_idx] = _position.z();
+	s.vx[_idx] = _velocity.x();
+	s.vy[_idx] = _velocity.y();
+	s.vz[_idx] = _velocity.z();
+}
+
+void ParticleStorage::loadState(StateLayout _layout, const void * _positions, const void * _velocities, std::size_t _begin, std::size_t _end)
+{
+	const ParticleStreams & s = m_streams;
+	if (_layout == StateLayout::Compact)
+	{
+		const float * pos = static_cast<const float *>(_positions);
+		const std::uint16_t * vel = static_cast<const std::uint16_t *>(_velocities);
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			s.px[i] = pos[3u * i];
+			s.py[i] = pos[3u * i + 1u];
+			s.pz[i] = pos[3u * i + 2u];
+			s.vx[i] = fhl::fromHalf(vel[4u * i]);
+			s.vy[i] = fhl::fromHalf(vel[4u * i + 1u]);
+			s.vz[i] = fhl::fromHalf(vel[4u * i + 2u]);
+		}
+	}
+	else
+	{
+		const fhl::Vec4f * pos = static_cast<const fhl::Vec4f *>(_positions);
+		const fhl::Vec4f * vel = static_cast<const fhl::Vec4f *>(_velocities);
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			s.px[i] = pos[i].x();
+			s.py[i] = pos[i].y();
+			s.pz[i] = pos[i].z();
+			s.vx[i] = vel[i].x();
+			s.vy[i] = vel[i].y();
+			s.vz[i] = vel[i].z();
+		}
+	}
+}
+
+void ParticleStorage::storeState(StateLayout _layout, void * _positions, void * _velocities, std::size_t _begin, std::size_t _end) const
+{
+	storePositions(_layout, _positions, _begin, _end);
+	storeVelocities(_layout, _velocities, _begin, _end);
+}
+
+void ParticleStorage::storePositions(StateLayout _layout, void * _positions, std::size_t _begin, std::size_t _end) const
+{
+	const ParticleStreams & s = m_streams;
+	if (_layout == StateLayout::Compact)
+	{
+		float * pos = static_cast<float *>(_positions);
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			pos[3u * i] = s.px[i];
+			pos[3u * i + 1u] = s.py[i];
+			pos[3u * i + 2u] = s.pz[i];
+		}
+	}
+	else
+	{
+		fhl::Vec4f * pos = static_cast<fhl::Vec4f *>(_positions);
+		for (std::size_t i = _begin; i < _end; ++i)
+			pos[i] = fhl::Vec4f{s.px[i], s.py[i], s.pz[i], 1.f};
+	}
+}
+
+void ParticleStorage::storeVelocities(StateLayout _layout, void * _velocities, std::size_t _begin, std::size_t _end) const
+{
+	const ParticleStreams & s = m_streams;
+	if (_layout == StateLayout::Compact)
+	{
+		std::uint16_t * vel = static_cast<std::uint16_t *>(_velocities);
+		for (std::size_t i = _begin; i < _end; ++i)
+		{
+			vel[4u * i] = fhl::toHalf(s.vx[i]);
+			vel[4u * i + 1u] = fhl::toHalf(s.vy[i]);
+			vel[4u * i + 2u] = fhl::toHalf(s.vz[i]);
+			vel[4u * i + 3u] = 0u;
+		}
+	}
+	else
+	{
+		fhl::Vec4f * vel = static_cast<fhl::Vec4f *>(_velocities);
+		for (std::size_t i = _begin; i < _end; ++i)
+			vel[i] = fhl::Vec4f{s.vx[i], s.vy[i], s.vz[i], 0.f};
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef PARTICLE_STORAGE_H
+#define PARTICLE_STORAGE_H
+
+#include "maths/vectors.h"
+#include "ParticleStreams.h"
+#include "StateLayout.h"
+
+#include <cstddef>
+
+/* Structure-of-arrays particle state. Every stream is 64-byte aligned and padded to a multiple of 16 floats. */
+class ParticleStorage
+{
+public:
+	enum { Alignment = 64, LaneMultiple = 16 };
+
+	explicit ParticleStorage(std::size_t _count = 0u);
+	ParticleStorage(ParticleStorage && _other) noexcept;
+	ParticleStorage & operator=(ParticleStorage && _other) noexcept;
+	~ParticleStorage();
+
+	ParticleStorage(const ParticleStorage &) = delete;
+	ParticleStorage & operator=(const ParticleStorage &) = delete;
+
+	std::size_t size() const { return m_count; }
+	const ParticleStreams & getStreams() const { return m_streams; }
+
+	void set(std::size_t _idx, const fhl::Vec3f & _position, const fhl::Vec3f & _velocity);
+
+	/* conversion from/to the layouts of the GL buffers; pointers address particle 0, w of vec4 positions is written as 1 */
+	void loadState(StateLayout _layout, const void * _positions, const void * _velocities, std::size_t _begin, std::size_t _end);
+	void storeState(StateLayout _layout, void * _positions, void * _velocities, std::size_t _begin, std::size_t _end) const;
+	void storePositions(StateLayout _layout, void * _positions, std::size_t _begin, std::size_t _end) const;
+	void storeVelocities(StateLayout _layout, void * _velocities, std::size_t _begin, std::size_t _end) const;
+
+private:
+	std::size_t m_count;
+	float * m_data;
+	ParticleStreams m_streams;
+};
+
+#endif
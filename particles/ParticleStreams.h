@@ -0,0 +1,15 @@
+#ifndef PARTICLE_STREAMS_H
+#define PARTICLE_STREAMS_H
+
+/* Pointers to the separate x/y/z streams of a ParticleStorage */
+struct ParticleStreams
+{
+	float * px;
+	float * py;
+	float * pz;
+	float * vx;
+	float * vy;
+	float * vz;
+};
+
+#endif
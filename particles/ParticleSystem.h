@@ -0,0 +1,39 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <cstddef>
+
+/*
+ * One particle system: the range [first, first + capacity) of the state buffers shared by all systems
+ * of a ParticleSystemManager, of which the first count particles are live (simulated and drawn), and its parameters.
+ * Changes are uploaded by the next ParticleSystemManager::upload(). Once shaders change the count on the GPU
+ * (emitters, compaction) the count here is only the initial one.
+ */
+class ParticleSystem
+{
+public:
+	ParticleSystem(std::size_t _first, std::size_t _capacity, float _attractorScale) :
+		m_first{_first}, m_capacity{_capacity}, m_count{_capacity}, m_attractorScale{_attractorScale}, m_dirty{true}, m_countDirty{true} {}
+
+	std::size_t getFirst() const { return m_first; }
+	std::size_t getCapacity() const { return m_capacity; }
+
+	std::size_t getCount() const { return m_count; }
+	/* clamped to the capacity */
+	void setCount(std::size_t _count) { m_count = _count < m_capacity ? _count : m_capacity; m_countDirty = true; }
+
+	float getAttractorScale() const { return m_attractorScale; }
+	void setAttractorScale(float _scale) { m_attractorScale = _scale; m_dirty = true; }
+
+private:
+	friend class ParticleSystemManager;
+
+	std::size_t m_first;
+	std::size_t m_capacity;
+	std::size_t m_count;
+	float m_attractorScale;
+	bool m_dirty; // parameters
+	bool m_countDirty;
+};
+
+#endif
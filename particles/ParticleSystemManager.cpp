@@ -0,0 +1,99 @@
+#include "ParticleSystemManager.h"
+
+ParticleSystemManager::ParticleSystemManager(std::size_t _capacity, std::size_t _maxSystems) :
+	m_capacity{_capacity},
+	m_maxSystems{_maxSystems},
+	m_used{0u},
+	m_liveCount{0u},
+	m_uploadedSystems{0u},
+	m_verticesPerParticle{0u},
+	m_systemBuffer{},
+	m_stateBuffer{}
+{
+	m_systems.reserve(m_maxSystems);
+	glCreateBuffers(1, &m_systemBuffer);
+	glNamedBufferStorage(m_systemBuffer, m_maxSystems * sizeof(SystemData), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	glCreateBuffers(1, &m_stateBuffer);
+	glNamedBufferStorage(m_stateBuffer, sizeof(StateHeader) + m_maxSystems * sizeof(SystemState), nullptr, GL_DYNAMIC_STORAGE_BIT);
+}
+
+ParticleSystemManager::~ParticleSystemManager()
+{
+	glDeleteBuffers(1, &m_systemBuffer);
+	glDeleteBuffers(1, &m_stateBuffer);
+}
+
+ParticleSystem * ParticleSystemManager::add(std::size_t _capacity, float _attractorScale)
+{
+	// whole workgroups of the range have to be inside the buffers
+	if (!_capacity || m_systems.size() == m_maxSystems || m_used + roundUp(_capacity) > m_capacity)
+		return nullptr;
+	m_systems.emplace_back(new ParticleSystem{m_used, _capacity, _attractorScale});
+	m_used += roundUp(_capacity);
+	return m_systems.back().get();
+}
+
+void ParticleSystemManager::upload(GLuint _verticesPerParticle)
+{
+	const bool added = m_uploadedSystems != m_systems.size();
+	bool paramsChanged = added, countsChanged = added || m_verticesPerParticle != _verticesPerParticle;
+	for (const std::unique_ptr<ParticleSystem> & system : m_systems)
+	{
+		paramsChanged = paramsChanged || system->m_dirty;
+		countsChanged = countsChanged || system->m_countDirty;
+	}
+
+	if (paramsChanged)
+	{
+		std::vector<SystemData> systems;
+		systems.reserve(m_systems.size());
+		for (const std::unique_ptr<ParticleSystem> & system : m_systems)
+		{
+			systems.push_back(SystemData{std::uint32_t(system->m_first), std::uint32_t(system->m_capacity), system->m_attractorScale, 0u});
+			system->m_dirty = false;
+		}
+		if (!systems.empty())
+			glNamedBufferSubData(m_systemBuffer, 0, systems.size() * sizeof(SystemData), systems.data());
+	}
+
+	if (countsChanged)
+	{ // same as updateSystemStates() of particle_systems.glsl
+		StateHeader header{{0u, 1u, 1u}, GLuint(m_systems.size()), _verticesPerParticle, {}};
+		std::vector<SystemState> states;
+		states.reserve(m_systems.size());
+		m_liveBase.clear();
+		m_liveCount = 0u;
+		for (const std::unique_ptr<ParticleSystem> & system : m_systems)
+		{
+			const GLuint count = GLuint(system->m_count);
+			states.push_back(SystemState{count * _verticesPerParticle, 1u, GLuint(system->m_first) * _verticesPerParticle, 0u, count, header.groups[0], {}});
+			header.groups[0] += GLuint(roundUp(count) / GroupSize);
+			m_liveBase.push_back(m_liveCount);
+			m_liveCount += count;
+			system->m_countDirty = false;
+		}
+		glNamedBufferSubData(m_stateBuffer, 0, sizeof(header), &header);
+		if (!states.empty())
+			glNamedBufferSubData(m_stateBuffer, sizeof(header), states.size() * sizeof(SystemState), states.data());
+	}
+	m_uploadedSystems = m_systems.size();
+	m_verticesPerParticle = _verticesPerParticle;
+}
+
+void ParticleSystemManager::bind() const
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::SystemBuffer, m_systemBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::SystemStateBuffer, m_stateBuffer);
+}
+
+void ParticleSystemManager::dispatch() const
+{
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_stateBuffer);
+	glDispatchComputeIndirect(0);
+}
+
+void ParticleSystemManager::draw(GLenum _mode) const
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_stateBuffer);
+	glMultiDrawArraysIndirect(_mode, reinterpret_cast<const void *>(sizeof(StateHeader)), GLsizei(m_systems.size()), sizeof(SystemState));
+}
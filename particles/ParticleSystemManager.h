@@ -0,0 +1,120 @@
+#ifndef PARTICLE_SYSTEM_MANAGER_H
+#define PARTICLE_SYSTEM_MANAGER_H
+
+#include "gl/flextGL.h"
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * Packs particle systems into consecutive ranges of the shared state buffers, so all of them are simulated
+ * by one dispatch and drawn by one glMultiDrawArraysIndirect with a command per system.
+ * Ranges start at multiples of the simulate.comp workgroup size. The system table (SSBO binding 5) holds the
+ * parameters; the state buffer (SSBO binding 6) holds per system counts with the draw commands and the indirect
+ * dispatch arguments derived from them, so shaders can change counts without a readback (see particle_systems.glsl).
+ * Dispatches cover (count + GroupSize - 1) / GroupSize workgroups per system. Must be created with the GL context current.
+ */
+class ParticleSystemManager
+{
+public:
+	enum { GroupSize = 64 };
+	enum Bindings { SystemBuffer = 5, SystemStateBuffer = 6 };
+
+	/* _capacity - particles in the shared buffers */
+	explicit ParticleSystemManager(std::size_t _capacity, std::size_t _maxSystems = 1024u);
+	~ParticleSystemManager();
+
+	ParticleSystemManager(const ParticleSystemManager &) = delete;
+	ParticleSystemManager & operator=(const ParticleSystemManager &) = delete;
+
+	/* reserves _capacity particles after the last system (rounded up to GroupSize), nullptr if they don't fit; all of them start live */
+	ParticleSystem * add(std::size_t _capacity, float _attractorScale = 1.f);
+
+	std::size_t getSystemCount() const { return m_systems.size(); }
+	ParticleSystem & getSystem(std::size_t _idx) { return *m_systems[_idx]; }
+	const ParticleSystem & getSystem(std::size_t _idx) const { return *m_systems[_idx]; }
+
+	std::size_t getCapacity() const { return m_capacity; }
+	std::size_t getMaxSystems() const { return m_maxSystems; }
+	/* end of the last system's range (a multiple of GroupSize) */
+	std::size_t getUsedCapacity() const { return m_used; }
+	/* live particles of all systems as of the last upload() */
+	std::size_t getLiveCount() const { return m_liveCount; }
+
+	/* writes the system table if a system was added or its parameters changed, and the counts, draw commands and
+	   dispatch arguments if a count changed (replacing counts shaders have written) */
+	void upload(GLuint _verticesPerParticle);
+	void bind() const;
+	/* glDispatchComputeIndirect over the particles in use of all systems */
+	void dispatch() const;
+	/* draws live particles of all systems, _mode and vertices per particle as in the last upload() */
+	void draw(GLenum _mode) const;
+
+	/* calls _func(system, begin, end) for every run of live particles of one system covering the live particle numbers
+	   [_begin, _end), live particles of all systems being numbered consecutively in system order; counts as of the last upload() */
+	template<typename Func>
+	void forEachLiveRange(std::size_t _begin, std::size_t _end, Func _func) const
+	{
+		std::size_t idx = std::size_t(std::upper_bound(m_liveBase.begin(), m_liveBase.end(), _begin) - m_liveBase.begin()) - 1u;
+		for (; _begin < _end && idx < m_systems.size(); ++idx)
+		{
+			const ParticleSystem & system = *m_systems[idx];
+			const std::size_t base = m_liveBase[idx];
+			const std::size_t end = std::min(_end, base + system.m_count);
+			if (_begin < end)
+				_func(system, system.m_first + _begin - base, system.m_first + end - base);
+			_begin = std::max(_begin, end);
+		}
+	}
+
+private:
+	static std::size_t roundUp(std::size_t _count) { return (_count + GroupSize - 1u) / GroupSize * GroupSize; }
+
+	// std430 ParticleSystem struct of particle_systems.glsl
+	struct SystemData
+	{
+		std::uint32_t first;
+		std::uint32_t capacity;
+		float attractorScale;
+		std::uint32_t padding;
+	};
+
+	// header of the SystemStates block of particle_systems.glsl
+	struct StateHeader
+	{
+		GLuint groups[3];
+		GLuint systemCount;
+		GLuint verticesPerParticle;
+		GLuint padding[3];
+	};
+
+	// std430 SystemState struct of particle_systems.glsl, starting with a DrawArraysIndirectCommand
+	struct SystemState
+	{
+		GLuint drawCount;
+		GLuint instanceCount;
+		GLuint drawFirst;
+		GLuint baseInstance;
+		GLuint count;
+		GLuint groupBase;
+		GLuint padding[2];
+	};
+
+	std::size_t m_capacity;
+	std::size_t m_maxSystems;
+	std::size_t m_used;
+	std::vector<std::unique_ptr<ParticleSystem>> m_systems;
+	std::vector<std::size_t> m_liveBase; // live particles of the systems before each one
+	std::size_t m_liveCount;
+	std::size_t m_uploadedSystems;
+	GLuint m_verticesPerParticle;
+
+	GLuint m_systemBuffer;
+	GLuint m_stateBuffer;
+};
+
+#endif
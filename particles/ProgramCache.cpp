@@ -0,0 +1,168 @@
+#include "ProgramCache.h"
+#include "utility/Hash.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#if defined(FHL_PLATFORM_WINDOWS)
+#include <direct.h>
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	struct BinaryHeader
+	{
+		enum : std::uint32_t { Magic = 0x4e425250u, Version = 1u }; // "PRBN"
+
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint64_t key;
+		std::uint32_t format; // GLenum from glGetProgramBinary
+		std::uint32_t size;
+	};
+
+	void makeDirectory(const char * _path)
+	{
+#if defined(FHL_PLATFORM_WINDOWS)
+		_mkdir(_path);
+#else
+		mkdir(_path, 0755);
+#endif
+	}
+
+	unsigned long getProcessId()
+	{
+#if defined(FHL_PLATFORM_WINDOWS)
+		return GetCurrentProcessId();
+#else
+		return (unsigned long)getpid();
+#endif
+	}
+
+	// std::rename does not replace an existing file on Windows
+	bool replaceFile(const char * _from, const char * _to)
+	{
+#if defined(FHL_PLATFORM_WINDOWS)
+		return MoveFileExA(_from, _to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+		return !std::rename(_from, _to);
+#endif
+	}
+
+	std::uint64_t hashString(const char * _str, std::uint64_t _hash)
+	{
+		// the terminating zero separates consecutive pieces
+		return _str ? fhl::fnv1a(_str, std::strlen(_str) + 1u, _hash) : fhl::fnv1a("", 1u, fhl::fnv1a("", 1u, _hash));
+	}
+}
+
+ProgramCache::ProgramCache(const char * _directory) :
+	m_directory{_directory},
+	m_driverHash{fhl::Fnv1aOffset},
+	m_enabled{false},
+	m_hits{0u},
+	m_misses{0u}
+{
+	GLint formats{};
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	m_enabled = formats > 0;
+	if (!m_enabled)
+		return;
+
+	for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+		m_driverHash = hashString(reinterpret_cast<const char *>(glGetString(name)), m_driverHash);
+	makeDirectory(m_directory.c_str());
+}
+
+std::uint64_t ProgramCache::makeKey(std::initializer_list<const char *> _sources) const
+{
+	std::uint64_t hash = m_driverHash;
+	for (const char * src : _sources)
+		hash = hashString(src, hash);
+	return hash;
+}
+
+GLuint ProgramCache::load(std::uint64_t _key)
+{
+	if (!m_enabled)
+		return 0;
+
+	std::FILE * file = std::fopen(getPath(_key).c_str(), "rb");
+	if (!file)
+	{
+		++m_misses;
+		return 0;
+	}
+	BinaryHeader header{};
+	std::vector<unsigned char> binary;
+	bool ok = std::fread(&header, sizeof(header), 1u, file) == 1u &&
+		header.magic == BinaryHeader::Magic && header.version == BinaryHeader::Version && header.key == _key;
+	if (ok)
+	{
+		binary.resize(header.size);
+		ok = std::fread(binary.data(), 1u, binary.size(), file) == binary.size();
+	}
+	std::fclose(file);
+
+	GLuint program{};
+	if (ok)
+	{
+		program = glCreateProgram();
+		glProgramBinary(program, header.format, binary.data(), GLsizei(binary.size()));
+		GLint success{};
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) // driver rejected the binary
+		{
+			glDeleteProgram(program);
+			program = 0;
+		}
+	}
+	if (program)
+		++m_hits;
+	else
+		++m_misses;
+	return program;
+}
+
+void ProgramCache::store(std::uint64_t _key, GLuint _program)
+{
+	if (!m_enabled || !_program)
+		return;
+
+	GLint length{};
+	glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+	std::vector<unsigned char> binary(static_cast<std::size_t>(length));
+	GLenum format{};
+	glGetProgramBinary(_program, length, &length, &format, binary.data());
+
+	BinaryHeader header{};
+	header.magic = BinaryHeader::Magic;
+	header.version = BinaryHeader::Version;
+	header.key = _key;
+	header.format = format;
+	header.size = std::uint32_t(length);
+
+	// written under a temporary name of this process and renamed, so concurrent runs neither read a partial file nor write into each other's
+	const std::string path = getPath(_key);
+	const std::string tmpPath = path + "." + std::to_string(getProcessId()) + ".tmp";
+	std::FILE * file = std::fopen(tmpPath.c_str(), "wb");
+	if (!file)
+		return;
+	const bool ok = std::fwrite(&header, sizeof(header), 1u, file) == 1u &&
+		std::fwrite(binary.data(), 1u, header.size, file) == header.size;
+	if (std::fclose(file) || !ok || !replaceFile(tmpPath.c_str(), path.c_str()))
+		std::remove(tmpPath.c_str());
+}
+
+std::string ProgramCache::getPath(std::uint64_t _key) const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "/%016llx.bin", (unsigned long long)_key);
+	return m_directory + name;
+}
@@ -0,0 +1,45 @@
+#ifndef PROGRAM_CACHE_H
+#define PROGRAM_CACHE_H
+
+#include "gl/flextGL.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+/*
+ * On-disk cache of linked program binaries (glGetProgramBinary/glProgramBinary).
+ * Keys hash the shader sources together with GL vendor, renderer and version, so a driver update misses the cache.
+ * Must be created with the GL context current.
+ */
+class ProgramCache
+{
+public:
+	explicit ProgramCache(const char * _directory);
+
+	/* false if the driver has no program binary formats; load() then always misses and store() does nothing */
+	bool isEnabled() const { return m_enabled; }
+
+	/* hash of the sources of all stages in order, nullptr for an absent stage */
+	std::uint64_t makeKey(std::initializer_list<const char *> _sources) const;
+
+	/* returns linked program or 0 if there is no usable binary for _key */
+	GLuint load(std::uint64_t _key);
+	/* _program must be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set */
+	void store(std::uint64_t _key, GLuint _program);
+
+	std::size_t getHits() const { return m_hits; }
+	std::size_t getMisses() const { return m_misses; }
+
+private:
+	std::string getPath(std::uint64_t _key) const;
+
+	std::string m_directory;
+	std::uint64_t m_driverHash;
+	bool m_enabled;
+	std::size_t m_hits;
+	std::size_t m_misses;
+};
+
+#endif
@@ -0,0 +1,222 @@
+#include "ProgramGroups.h"
+#include "ProgramCache.h"
+#include "ShaderDefines.h"
+#include "ShaderSources.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+	const char * const GLSL_VERSION = "#version 430 core\n";
+
+	GLuint makeCs(const char * const _defines, const char * const _src, ProgramCache * _cache)
+	{
+		const char * const sources[] = { GLSL_VERSION, _defines, _src };
+		const std::uint64_t key = _cache ? _cache->makeKey({sources[0], sources[1], sources[2]}) : 0u;
+		if (_cache)
+			if (GLuint cached = _cache->load(key))
+				return cached;
+
+		GLuint program = glCreateProgram();
+		GLuint cs = glCreateShader(GL_COMPUTE_SHADER);
+		glShaderSource(cs, 3, sources, nullptr);
+		glCompileShader(cs);
+
+		{ // check for compilation errors
+			GLint success{};
+			GLchar infoLog[0x200];
+			glGetShaderiv(cs, GL_COMPILE_STATUS, &success);
+			if (!success)
+			{
+				glGetShaderInfoLog(cs, 0x200, nullptr, infoLog);
+				std::printf("CS COMPILATION ERROR: %s\n", infoLog);
+				glDeleteShader(cs);
+				glDeleteProgram(program);
+				return 0;
+			}
+		}
+		glAttachShader(program, cs);
+		if (_cache)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(program);
+
+		glDetachShader(program, cs);
+		glDeleteShader(cs);
+
+		GLint success;
+		GLchar infoLog[0x200];
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) {
+			glGetProgramInfoLog(program, 0x200, nullptr, infoLog);
+			printf("CS LINK ERROR: %s\n", infoLog);
+			glDeleteProgram(program);
+			return 0;
+		}
+		else if (_cache)
+			_cache->store(key, program);
+
+		return program;
+	}
+
+	GLuint makeGeneralShader(const char * const _defines, const char * const _vs, const char * const _gs, const char * const _fs, ProgramCache * _cache)
+	{
+		const std::uint64_t key = _cache ? _cache->makeKey({GLSL_VERSION, _defines, _vs, _gs, _fs}) : 0u;
+		if (_cache)
+			if (GLuint cached = _cache->load(key))
+				return cached;
+
+		GLuint program = glCreateProgram();
+		GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+		const char * const vsSources[] = { GLSL_VERSION, _defines, _vs };
+		glShaderSource(vs, 3, vsSources, nullptr);
+		glCompileShader(vs);
+		GLuint gs{};
+		if (_gs)
+		{
+			gs = glCreateShader(GL_GEOMETRY_SHADER);
+			const char * const gsSources[] = { GLSL_VERSION, _defines, _gs };
+			glShaderSource(gs, 3, gsSources, nullptr);
+			glCompileShader(gs);
+		}
+		GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+		const char * const fsSources[] = { GLSL_VERSION, _defines, _fs };
+		glShaderSource(fs, 3, fsSources, nullptr);
+		glCompileShader(fs);
+
+		GLchar infoLog[0x200];
+		for (GLuint s : {vs, gs, fs})
+		{ // check for compilation errors
+			if (!s)
+				continue;
+			GLint success{};
+			glGetShaderiv(s, GL_COMPILE_STATUS, &success);
+			if (!success)
+			{
+				glGetShaderInfoLog(s, 0x200, nullptr, infoLog);
+				std::printf("VS/GS/FS COMPILATION ERROR: %s", infoLog);
+				for (GLuint stage : {vs, gs, fs})
+					glDeleteShader(stage);
+				glDeleteProgram(program);
+				return 0;
+			}
+		}
+		for (GLuint s : {vs, gs, fs})
+			if (s)
+				glAttachShader(program, s);
+		if (_cache)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(program);
+
+		for (GLuint s : {vs, gs, fs})
+		{
+			if (!s)
+				continue;
+			glDetachShader(program, s);
+			glDeleteShader(s);
+		}
+
+		GLint success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) {
+			glGetProgramInfoLog(program, 0x200, nullptr, infoLog);
+			printf("VS/GS/FS LINK ERROR: %s\n", infoLog);
+			glDeleteProgram(program);
+			return 0;
+		}
+		else if (_cache)
+			_cache->store(key, program);
+
+		return program;
+	}
+
+	void deletePrograms(const std::vector<GLuint> & _programs)
+	{
+		for (GLuint program : _programs)
+			glDeleteProgram(program);
+	}
+}
+
+ProgramGroups::Builder::Builder(const ShaderSources & _sources, ProgramCache * _cache) :
+	m_sources(_sources),
+	m_cache{_cache},
+	m_failed{false}
+{
+}
+
+GLuint ProgramGroups::Builder::compute(const ShaderDefines & _defines, std::initializer_list<const char *> _files)
+{
+	return add(makeCs(_defines.c_str(), concat(_files).c_str(), m_cache));
+}
+
+GLuint ProgramGroups::Builder::render(const ShaderDefines & _defines, std::initializer_list<const char *> _vsFiles,
+	std::initializer_list<const char *> _gsFiles, std::initializer_list<const char *> _fsFiles)
+{
+	const std::string gs = concat(_gsFiles);
+	return add(makeGeneralShader(_defines.c_str(), concat(_vsFiles).c_str(), _gsFiles.size() ? gs.c_str() : nullptr, concat(_fsFiles).c_str(), m_cache));
+}
+
+std::string ProgramGroups::Builder::concat(std::initializer_list<const char *> _files)
+{
+	std::string src;
+	for (const char * file : _files)
+	{
+		src += m_sources.get(file);
+		if (std::find(m_files.begin(), m_files.end(), file) == m_files.end())
+			m_files.push_back(file);
+	}
+	return src;
+}
+
+GLuint ProgramGroups::Builder::add(GLuint _program)
+{
+	if (_program)
+		m_programs.push_back(_program);
+	else
+		m_failed = true;
+	return _program;
+}
+
+ProgramGroups::ProgramGroups(const ShaderSources & _sources, ProgramCache * _cache) :
+	m_sources(_sources),
+	m_cache{_cache}
+{
+}
+
+ProgramGroups::~ProgramGroups()
+{
+	clear();
+}
+
+void ProgramGroups::reload(const std::vector<std::string> & _changed)
+{
+	for (const std::unique_ptr<Group> & group : m_groups)
+	{
+		const bool changed = std::any_of(group->files.begin(), group->files.end(), [&](const std::string & _file) {
+			return std::find(_changed.begin(), _changed.end(), _file) != _changed.end();
+		});
+		if (!changed)
+			continue;
+
+		Builder builder{m_sources, m_cache};
+		group->build(builder);
+		if (builder.m_failed)
+		{ // all programs or none, those of a group share buffers and parameters
+			deletePrograms(builder.m_programs);
+			std::printf("Keeping previous %s programs\n", group->name);
+			continue;
+		}
+		deletePrograms(group->programs);
+		group->programs = std::move(builder.m_programs);
+		group->files = std::move(builder.m_files);
+		group->apply();
+		std::printf("Reloaded %s programs\n", group->name);
+	}
+}
+
+void ProgramGroups::clear()
+{
+	for (const std::unique_ptr<Group> & group : m_groups)
+		deletePrograms(group->programs);
+	m_groups.clear();
+}
@@ -0,0 +1,111 @@
+#ifndef PROGRAM_GROUPS_H
+#define PROGRAM_GROUPS_H
+
+#include "gl/flextGL.h"
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ProgramCache;
+class ShaderDefines;
+class ShaderSources;
+
+/*
+ * Programs of the subsystems, built from files of ShaderSources in groups that are only replaced as a whole.
+ * A group's build function compiles its programs through a Builder, which records the files every program is made of,
+ * so a group names its sources once. reload() rebuilds the groups using a changed file; if all programs of a group
+ * linked they are handed to the subsystem by the group's apply function and the previous ones are deleted,
+ * otherwise the subsystem keeps running the previous ones. Must be used with the GL context current.
+ */
+class ProgramGroups
+{
+public:
+	class Builder
+	{
+	public:
+		/* compute program of _files concatenated in order, 0 if it fails to compile or link */
+		GLuint compute(const ShaderDefines & _defines, std::initializer_list<const char *> _files);
+		/* program of vertex, geometry (none for empty _gsFiles) and fragment stages, 0 if it fails to compile or link */
+		GLuint render(const ShaderDefines & _defines, std::initializer_list<const char *> _vsFiles,
+			std::initializer_list<const char *> _gsFiles, std::initializer_list<const char *> _fsFiles);
+
+	private:
+		friend class ProgramGroups;
+
+		Builder(const ShaderSources & _sources, ProgramCache * _cache);
+
+		std::string concat(std::initializer_list<const char *> _files);
+		GLuint add(GLuint _program);
+
+		const ShaderSources & m_sources;
+		ProgramCache * m_cache;
+		std::vector<GLuint> m_programs; // linked ones
+		std::vector<std::string> m_files;
+		bool m_failed;
+	};
+
+	ProgramGroups(const ShaderSources & _sources, ProgramCache * _cache);
+	~ProgramGroups();
+
+	ProgramGroups(const ProgramGroups &) = delete;
+	ProgramGroups & operator=(const ProgramGroups &) = delete;
+
+	/*
+	 * builds a group with _build(Builder &), returning its programs (0 for the ones that failed);
+	 * reloaded programs are passed to _apply(const Programs &)
+	 */
+	template<typename Build, typename Apply>
+	auto add(const char * _name, Build _build, Apply _apply)
+	{
+		using Programs = decltype(_build(std::declval<Builder &>()));
+		std::unique_ptr<TypedGroup<Programs, Build, Apply>> group{new TypedGroup<Programs, Build, Apply>(_name, std::move(_build), std::move(_apply))};
+		Builder builder{m_sources, m_cache};
+		group->build(builder);
+		group->programs = std::move(builder.m_programs);
+		group->files = std::move(builder.m_files);
+		const Programs programs = group->built;
+		m_groups.push_back(std::move(group));
+		return programs;
+	}
+
+	/* _changed - names of the files whose sources were reloaded */
+	void reload(const std::vector<std::string> & _changed);
+	/* deletes the programs of all groups */
+	void clear();
+
+private:
+	struct Group
+	{
+		explicit Group(const char * _name) : name{_name} {}
+		virtual ~Group() = default;
+
+		virtual void build(Builder & _builder) = 0;
+		virtual void apply() const = 0; // hands the last built programs to the subsystem
+
+		const char * name;
+		std::vector<GLuint> programs;
+		std::vector<std::string> files;
+	};
+
+	template<typename Programs, typename Build, typename Apply>
+	struct TypedGroup : Group
+	{
+		TypedGroup(const char * _name, Build _build, Apply _apply) : Group{_name}, buildFunc(std::move(_build)), applyFunc(std::move(_apply)), built{} {}
+
+		void build(Builder & _builder) override { built = buildFunc(_builder); }
+		void apply() const override { applyFunc(built); }
+
+		Build buildFunc;
+		Apply applyFunc;
+		Programs built;
+	};
+
+	const ShaderSources & m_sources;
+	ProgramCache * m_cache;
+	std::vector<std::unique_ptr<Group>> m_groups;
+};
+
+#endif
@@ -0,0 +1,325 @@
+#include "Recording.h"
+#include "utility/Lz.h"
+#include "utility/Trace.h"
+
+#include <cstring>
+#include <utility>
+
+namespace
+{
+	/*
+	 * Byte planes of 4-byte words: byte b of word i goes to b * wordCount + i. XOR deltas of floats differ mostly
+	 * in the low mantissa bytes, so the planes of the high bytes become long zero runs.
+	 */
+	void shuffleXor(const unsigned char * _src, const unsigned char * _previous, unsigned char * _dst, std::size_t _size)
+	{
+		const std::size_t words = _size / 4u;
+		for (std::size_t i = 0u; i < words; ++i)
+			for (std::size_t b = 0u; b < 4u; ++b)
+				_dst[b * words + i] = _src[4u * i + b] ^ (_previous ? _previous[4u * i + b] : 0u);
+	}
+
+	void unshuffleXor(const unsigned char * _src, unsigned char * _dst, std::size_t _size, bool _keyframe)
+	{
+		const std::size_t words = _size / 4u;
+		for (std::size_t i = 0u; i < words; ++i)
+			for (std::size_t b = 0u; b < 4u; ++b)
+				_dst[4u * i + b] = _src[b * words + i] ^ (_keyframe ? 0u : _dst[4u * i + b]);
+	}
+
+	bool seek(std::FILE * _file, std::uint64_t _offset, int _origin)
+	{
+#if defined(_MSC_VER)
+		return !_fseeki64(_file, __int64(_offset), _origin);
+#else
+		return !fseeko(_file, off_t(_offset), _origin);
+#endif
+	}
+
+	std::uint64_t tell(std::FILE * _file)
+	{
+#if defined(_MSC_VER)
+		return std::uint64_t(_ftelli64(_file));
+#else
+		return std::uint64_t(ftello(_file));
+#endif
+	}
+}
+
+RecordingWriter::RecordingWriter(const char * _path, const SnapshotInfo & _info, std::size_t _queueFrames, unsigned _keyframeInterval) :
+	m_file{std::fopen(_path, "wb")},
+	m_positionsSize{_info.particleCount * getPositionStride(_info.layout)},
+	m_keyframeInterval{_keyframeInterval ? _keyframeInterval : 1u},
+	m_frames(_queueFrames ? _queueFrames : 1u),
+	m_stop{false},
+	m_dropped{0u},
+	m_offset{0u},
+	m_failed{false}
+{
+	if (!m_file)
+	{
+		std::printf("Could not open %s for writing\n", _path);
+		return;
+	}
+
+	RecordingHeader header{};
+	header.magic = RecordingHeader::Magic;
+	header.version = RecordingHeader::Version;
+	header.particleCount = _info.particleCount;
+	header.layout = std::uint32_t(_info.layout);
+	header.timestep = _info.timestep;
+	header.keyframeInterval = m_keyframeInterval;
+	m_failed = std::fwrite(&header, sizeof(header), 1u, m_file) != 1u;
+	m_offset = sizeof(header);
+
+	const std::size_t frameSize = m_positionsSize + _info.particleCount * getVelocityStride(_info.layout);
+	for (std::size_t i = 0u; i < m_frames.size(); ++i)
+	{
+		m_frames[i].data.resize(frameSize);
+		m_free.push_back(i);
+	}
+	m_delta.resize(frameSize);
+	m_compressed.resize(fhl::lz::compressBound(frameSize));
+
+	m_thread = std::thread(&RecordingWriter::writeLoop, this);
+}
+
+RecordingWriter::~RecordingWriter()
+{
+	if (!m_file)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cv.notify_one();
+	m_thread.join();
+
+	RecordingFooter footer{};
+	footer.indexOffset = m_offset;
+	footer.frameCount = m_index.size();
+	footer.magic = RecordingHeader::Magic;
+	if (!m_index.empty())
+		m_failed |= std::fwrite(m_index.data(), sizeof(RecordingIndexEntry), m_index.size(), m_file) != m_index.size();
+	m_failed |= std::fwrite(&footer, sizeof(footer), 1u, m_file) != 1u;
+	m_failed |= std::fclose(m_file) != 0;
+	if (m_failed)
+		std::printf("Writing the recording failed, the file is incomplete\n");
+}
+
+bool RecordingWriter::record(std::uint64_t _step, const FillFunc & _fill)
+{
+	if (!m_file)
+		return false;
+
+	std::size_t slot;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_free.empty())
+		{
+			++m_dropped;
+			return false;
+		}
+		slot = m_free.back();
+		m_free.pop_back();
+	}
+
+	Frame & frame = m_frames[slot];
+	frame.step = _step;
+	_fill(frame.data.data(), frame.data.data() + m_positionsSize);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending.push_back(slot);
+	}
+	m_cv.notify_one();
+	return true;
+}
+
+std::size_t RecordingWriter::getRecordedFrames() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_index.size() + m_pending.size();
+}
+
+std::size_t RecordingWriter::getDroppedFrames() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_dropped;
+}
+
+std::uint64_t RecordingWriter::getWrittenBytes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_offset;
+}
+
+void RecordingWriter::writeLoop()
+{
+	fhl::trace::setThreadName("recorder");
+	for (;;)
+	{
+		std::size_t slot;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+			if (m_pending.empty())
+				return;
+			slot = m_pending.front();
+			m_pending.pop_front();
+		}
+
+		writeFrame(m_frames[slot]);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_free.push_back(slot);
+	}
+}
+
+void RecordingWriter::writeFrame(Frame & _frame)
+{
+	fhl::trace::Scope scope{"write recording frame"};
+	const std::size_t size = m_delta.size();
+	const bool keyframe = m_index.size() % m_keyframeInterval == 0u;
+	shuffleXor(_frame.data.data(), keyframe ? nullptr : m_previous.data(), m_delta.data(), size);
+	const std::size_t compressedSize = fhl::lz::compress(m_delta.data(), size, m_compressed.data());
+
+	// the written frame becomes the reference of the next one, the slot gets the old reference buffer
+	std::swap(_frame.data, m_previous);
+	_frame.data.resize(size);
+
+	if (m_failed)
+		return;
+	if (std::fwrite(m_compressed.data(), 1u, compressedSize, m_file) != compressedSize)
+	{
+		m_failed = true;
+		return;
+	}
+
+	RecordingIndexEntry entry{};
+	entry.offset = m_offset;
+	entry.step = _frame.step;
+	entry.size = std::uint32_t(compressedSize);
+	entry.flags = keyframe ? RecordingIndexEntry::Keyframe : 0u;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_index.push_back(entry);
+	m_offset += compressedSize;
+}
+
+RecordingReader::RecordingReader() :
+	m_file{nullptr},
+	m_info{},
+	m_positionsSize{0u},
+	m_stateFrame{std::size_t(-1)}
+{
+}
+
+RecordingReader::~RecordingReader()
+{
+	close();
+}
+
+bool RecordingReader::open(const char * _path)
+{
+	close();
+
+	m_file = std::fopen(_path, "rb");
+	if (!m_file)
+	{
+		std::printf("Could not open recording %s\n", _path);
+		return false;
+	}
+
+	RecordingHeader header;
+	RecordingFooter footer;
+	bool ok = std::fread(&header, sizeof(header), 1u, m_file) == 1u &&
+		header.magic == RecordingHeader::Magic && header.version == RecordingHeader::Version &&
+		header.layout <= std::uint32_t(StateLayout::Compact);
+	ok = ok && seek(m_file, 0u, SEEK_END);
+	const std::uint64_t fileSize = ok ? tell(m_file) : 0u;
+	ok = ok && fileSize >= sizeof(header) + sizeof(footer) &&
+		seek(m_file, fileSize - sizeof(footer), SEEK_SET) &&
+		std::fread(&footer, sizeof(footer), 1u, m_file) == 1u &&
+		footer.magic == RecordingHeader::Magic &&
+		footer.indexOffset <= fileSize - sizeof(footer) &&
+		footer.frameCount == (fileSize - sizeof(footer) - footer.indexOffset) / sizeof(RecordingIndexEntry);
+	if (ok)
+	{
+		m_index.resize(std::size_t(footer.frameCount));
+		ok = seek(m_file, footer.indexOffset, SEEK_SET) &&
+			std::fread(m_index.data(), sizeof(RecordingIndexEntry), m_index.size(), m_file) == m_index.size();
+		for (std::size_t i = 0u; ok && i < m_index.size(); ++i)
+			ok = m_index[i].offset <= footer.indexOffset && m_index[i].size <= footer.indexOffset - m_index[i].offset;
+		ok = ok && (m_index.empty() || m_index[0].flags & RecordingIndexEntry::Keyframe);
+	}
+	if (!ok)
+	{
+		std::printf("%s is not a valid recording or it was not closed properly\n", _path);
+		close();
+		return false;
+	}
+
+	m_info = SnapshotInfo{std::size_t(header.particleCount), StateLayout(header.layout), header.timestep, 0u};
+	m_positionsSize = m_info.particleCount * getPositionStride(m_info.layout);
+	m_state.resize(m_positionsSize + m_info.particleCount * getVelocityStride(m_info.layout));
+	m_shuffled.resize(m_state.size());
+	return true;
+}
+
+void RecordingReader::close()
+{
+	if (m_file)
+		std::fclose(m_file);
+	m_file = nullptr;
+	m_info = SnapshotInfo{};
+	m_positionsSize = 0u;
+	m_index.clear();
+	m_state = std::vector<unsigned char>();
+	m_stateFrame = std::size_t(-1);
+	m_shuffled = std::vector<unsigned char>();
+	m_compressed = std::vector<unsigned char>();
+}
+
+bool RecordingReader::readFrame(std::size_t _frame, void * _positions, void * _velocities)
+{
+	if (!m_file || _frame >= m_index.size())
+		return false;
+
+	// continue from the decoded frame if no keyframe is in between, otherwise restart at the closest keyframe
+	const bool continues = m_stateFrame != std::size_t(-1) && m_stateFrame < _frame;
+	std::size_t first = _frame;
+	while (!(m_index[first].flags & RecordingIndexEntry::Keyframe) && !(continues && first == m_stateFrame + 1u))
+		--first;
+	if (m_stateFrame == _frame)
+		first = _frame + 1u;
+
+	for (std::size_t f = first; f <= _frame; ++f)
+	{
+		if (!decodeFrame(f))
+		{
+			m_stateFrame = std::size_t(-1);
+			return false;
+		}
+		m_stateFrame = f;
+	}
+
+	std::memcpy(_positions, m_state.data(), m_positionsSize);
+	std::memcpy(_velocities, m_state.data() + m_positionsSize, m_state.size() - m_positionsSize);
+	return true;
+}
+
+bool RecordingReader::decodeFrame(std::size_t _frame)
+{
+	const RecordingIndexEntry & entry = m_index[_frame];
+	m_compressed.resize(entry.size);
+	if (!seek(m_file, entry.offset, SEEK_SET) || std::fread(m_compressed.data(), 1u, entry.size, m_file) != entry.size ||
+		!fhl::lz::decompress(m_compressed.data(), entry.size, m_shuffled.data(), m_shuffled.size()))
+	{
+		std::printf("Recording frame %zu is corrupted\n", _frame);
+		return false;
+	}
+	unshuffleXor(m_shuffled.data(), m_state.data(), m_state.size(), (entry.flags & RecordingIndexEntry::Keyframe) != 0u);
+	return true;
+}
@@ -0,0 +1,149 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include "Snapshot.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Recording file, little-endian:
+ *  RecordingHeader (64 bytes)
+ *  frames - lz-compressed, byte-shuffled XOR delta of positions+velocities against the previous frame
+ *           (against zero for keyframes)
+ *  RecordingIndexEntry[frameCount]
+ *  RecordingFooter
+ */
+struct RecordingHeader
+{
+	enum : std::uint32_t { Magic = 0x43455250u, Version = 1u }; // "PREC"
+
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint64_t particleCount;
+	std::uint32_t layout; // StateLayout
+	float timestep;
+	std::uint32_t keyframeInterval;
+	std::uint8_t reserved[36];
+};
+static_assert(sizeof(RecordingHeader) == 64u, "RecordingHeader must stay 64 bytes");
+
+struct RecordingIndexEntry
+{
+	enum : std::uint32_t { Keyframe = 1u };
+
+	std::uint64_t offset;
+	std::uint64_t step;
+	std::uint32_t size;
+	std::uint32_t flags;
+};
+
+struct RecordingFooter
+{
+	std::uint64_t indexOffset;
+	std::uint64_t frameCount;
+	std::uint32_t magic;
+	std::uint32_t reserved;
+};
+
+/*
+ * Writes frames from a background thread. Frames go through a queue of _queueFrames preallocated buffers;
+ * when all of them are waiting to be written the frame is dropped instead of blocking the caller.
+ */
+class RecordingWriter
+{
+public:
+	/* receives pointers to positions and velocities in the recording layout */
+	using FillFunc = std::function<void(void *, void *)>;
+
+	RecordingWriter(const char * _path, const SnapshotInfo & _info, std::size_t _queueFrames, unsigned _keyframeInterval);
+	~RecordingWriter(); // writes queued frames and the index
+
+	RecordingWriter(const RecordingWriter &) = delete;
+	RecordingWriter & operator=(const RecordingWriter &) = delete;
+
+	bool isOpen() const { return m_file != nullptr; }
+
+	/* returns false if the frame was dropped, _fill is not called then */
+	bool record(std::uint64_t _step, const FillFunc & _fill);
+
+	std::size_t getRecordedFrames() const;
+	std::size_t getDroppedFrames() const;
+	std::uint64_t getWrittenBytes() const;
+
+private:
+	struct Frame
+	{
+		std::vector<unsigned char> data;
+		std::uint64_t step;
+	};
+
+	void writeLoop();
+	void writeFrame(Frame & _frame);
+
+	std::FILE * m_file;
+	std::size_t m_positionsSize;
+	unsigned m_keyframeInterval;
+
+	std::vector<Frame> m_frames;
+	std::vector<std::size_t> m_free;
+	std::deque<std::size_t> m_pending;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_stop;
+	std::size_t m_dropped;
+
+	// owned by the writer thread
+	std::vector<unsigned char> m_previous;
+	std::vector<unsigned char> m_delta;
+	std::vector<unsigned char> m_compressed;
+	std::vector<RecordingIndexEntry> m_index;
+	std::uint64_t m_offset;
+	bool m_failed;
+
+	std::thread m_thread;
+};
+
+/* Random access to the frames of a recording; sequential reads decode one frame each, others start at the closest keyframe */
+class RecordingReader
+{
+public:
+	RecordingReader();
+	~RecordingReader();
+
+	RecordingReader(const RecordingReader &) = delete;
+	RecordingReader & operator=(const RecordingReader &) = delete;
+
+	/* prints the reason and returns false if the file cannot be read or is not a valid recording */
+	bool open(const char * _path);
+	void close();
+
+	const SnapshotInfo & getInfo() const { return m_info; }
+	std::size_t getFrameCount() const { return m_index.size(); }
+	std::uint64_t getFrameStep(std::size_t _frame) const { return m_index[_frame].step; }
+
+	/* arrays are in getInfo().layout */
+	bool readFrame(std::size_t _frame, void * _positions, void * _velocities);
+
+private:
+	bool decodeFrame(std::size_t _frame);
+
+	std::FILE * m_file;
+	SnapshotInfo m_info;
+	std::size_t m_positionsSize;
+	std::vector<RecordingIndexEntry> m_index;
+
+	std::vector<unsigned char> m_state;
+	std::size_t m_stateFrame;
+	std::vector<unsigned char> m_shuffled;
+	std::vector<unsigned char> m_compressed;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#include "ReplayParticleSimulator.h"
+
+ReplayParticleSimulator::ReplayParticleSimulator(RecordingReader & _reader, GLuint _positions, GLuint _velocities) :
+	m_reader(_reader),
+	m_positions{_positions},
+	m_velocities{_velocities},
+	m_frame{0u},
+	m_positionData(getParticleCount() * getPositionStride(_reader.getInfo().layout)),
+	m_velocityData(getParticleCount() * getVelocityStride(_reader.getInfo().layout))
+{
+}
+
+void ReplayParticleSimulator::update(const SimulationParams &)
+{
+	if (!m_reader.getFrameCount())
+		return;
+
+	m_frame = (m_frame + 1u) % m_reader.getFrameCount();
+	if (!m_reader.readFrame(m_frame, m_positionData.data(), m_velocityData.data()))
+		return;
+	glNamedBufferSubData(m_positions, 0, m_positionData.size(), m_positionData.data());
+	glNamedBufferSubData(m_velocities, 0, m_velocityData.size(), m_velocityData.data());
+}
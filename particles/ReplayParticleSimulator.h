@@ -0,0 +1,30 @@
+#ifndef REPLAY_PARTICLE_SIMULATOR_H
+#define REPLAY_PARTICLE_SIMULATOR_H
+
+#include "gl/flextGL.h"
+#include "ParticleSimulator.h"
+#include "Recording.h"
+
+#include <vector>
+
+/* Plays a recording back into the position/velocity buffers, one recorded frame per update, looping at the end */
+class ReplayParticleSimulator : public ParticleSimulator
+{
+public:
+	ReplayParticleSimulator(RecordingReader & _reader, GLuint _positions, GLuint _velocities);
+
+	void update(const SimulationParams & _params) override;
+	std::size_t getParticleCount() const override { return m_reader.getInfo().particleCount; }
+
+	std::size_t getFrame() const { return m_frame; }
+
+private:
+	RecordingReader & m_reader;
+	GLuint m_positions;
+	GLuint m_velocities;
+	std::size_t m_frame;
+	std::vector<unsigned char> m_positionData;
+	std::vector<unsigned char> m_velocityData;
+};
+
+#endif
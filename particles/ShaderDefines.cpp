@@ -0,0 +1,43 @@
+#include "ShaderDefines.h"
+
+#include <cstdio>
+#include <cstring>
+
+ShaderDefines & ShaderDefines::define(const char * _name)
+{
+	m_source += "#define ";
+	m_source += _name;
+	m_source += '\n';
+	return *this;
+}
+
+ShaderDefines & ShaderDefines::define(const char * _name, float _value)
+{
+	// enough digits to read back the same float; always a floating-point literal in GLSL
+	char value[32];
+	std::snprintf(value, sizeof(value), "%.9g", _value);
+	if (!std::strpbrk(value, ".eEni"))
+		std::strcat(value, ".0");
+	m_source += "#define ";
+	m_source += _name;
+	m_source += ' ';
+	m_source += value;
+	m_source += '\n';
+	return *this;
+}
+
+ShaderDefines & ShaderDefines::define(const char * _name, int _value)
+{
+	m_source += "#define ";
+	m_source += _name;
+	m_source += ' ';
+	m_source += std::to_string(_value);
+	m_source += '\n';
+	return *this;
+}
+
+ShaderDefines & ShaderDefines::append(const char * _lines)
+{
+	m_source += _lines;
+	return *this;
+}
@@ -0,0 +1,22 @@
+#ifndef SHADER_DEFINES_H
+#define SHADER_DEFINES_H
+
+#include <string>
+
+/* #define block put between the #version line and shader sources, selects features and bakes constants into a program variant */
+class ShaderDefines
+{
+public:
+	ShaderDefines & define(const char * _name);
+	ShaderDefines & define(const char * _name, float _value);
+	ShaderDefines & define(const char * _name, int _value);
+	/* already formatted #define lines, e.g. getStateLayoutDefines() */
+	ShaderDefines & append(const char * _lines);
+
+	const char * c_str() const { return m_source.c_str(); }
+
+private:
+	std::string m_source;
+};
+
+#endif
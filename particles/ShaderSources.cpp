@@ -0,0 +1,36 @@
+#include "ShaderSources.h"
+
+#include <cstdio>
+#include <utility>
+
+bool ShaderSources::load(const std::string & _name)
+{
+	const std::string path = m_directory + '/' + _name;
+	std::FILE * file = std::fopen(path.c_str(), "rb");
+	if (!file)
+	{
+		std::printf("Could not open shader %s\n", path.c_str());
+		return false;
+	}
+	std::string text;
+	char buffer[4096];
+	std::size_t read;
+	while ((read = std::fread(buffer, 1u, sizeof(buffer), file)) > 0u)
+		text.append(buffer, read);
+	const bool ok = !std::ferror(file);
+	std::fclose(file);
+	if (!ok)
+	{
+		std::printf("Could not read shader %s\n", path.c_str());
+		return false;
+	}
+	m_sources[_name] = std::move(text);
+	return true;
+}
+
+const std::string & ShaderSources::get(const std::string & _name) const
+{
+	static const std::string empty;
+	auto it = m_sources.find(_name);
+	return it == m_sources.end() ? empty : it->second;
+}
@@ -0,0 +1,25 @@
+#ifndef SHADER_SOURCES_H
+#define SHADER_SOURCES_H
+
+#include <map>
+#include <string>
+
+/* Text of the shader files in one directory (res/shaders), read on load() and kept until the next one */
+class ShaderSources
+{
+public:
+	explicit ShaderSources(const char * _directory) : m_directory{_directory} {}
+
+	/* false if the file can't be read, the previously loaded text is kept then */
+	bool load(const std::string & _name);
+	/* empty string if _name was never loaded */
+	const std::string & get(const std::string & _name) const;
+
+	const std::string & getDirectory() const { return m_directory; }
+
+private:
+	std::string m_directory;
+	std::map<std::string, std::string> m_sources;
+};
+
+#endif
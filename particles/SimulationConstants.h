@@ -0,0 +1,26 @@
+#ifndef SIMULATION_CONSTANTS_H
+#define SIMULATION_CONSTANTS_H
+
+/* Constants of the particle step and shading, used by the CPU kernels and baked into shaders as #defines */
+namespace constants
+{
+	const float DAMPING = .99f; // fraction of velocity lost per second
+	const float ATTRACTOR_ACCELERATION = 10000.f;
+	const float ATTRACTOR_FALLOFF = .01f; // acceleration is ATTRACTOR_ACCELERATION / max(1, ATTRACTOR_FALLOFF * dist^1.5)
+	const float FORCE_FIELD_MIN_DISTANCE = .001f; // Point and Vortex directions are divided by at least this distance
+	const float COLOR_MAX_SPEED = 700.f; // speed at which particles reach HI_COLOR
+
+	// particle-particle interaction within the interaction radius h, for a neighbour at distance r = q * h:
+	// acceleration away from it of INTERACTION_REPULSION * (1 - q)^2 - INTERACTION_COHESION * q * (1 - q)
+	const float INTERACTION_REPULSION = 2000.f;
+	const float INTERACTION_COHESION = 2000.f;
+	const int INTERACTION_MAX_NEIGHBOURS = 32; // further neighbours (in cell order) are ignored so dense clusters stay cheap
+	const int HASH_CELL_BITS = 7; // the hash grid wraps every 2^HASH_CELL_BITS cells along each axis
+
+	// gravity between unit mass particles at distance r: acceleration GRAVITY_CONSTANT * r / (r^2 + GRAVITY_SOFTENING^2)^1.5
+	const float GRAVITY_CONSTANT = 1.f;
+	const float GRAVITY_SOFTENING = 1.f; // keeps close pairs from being flung apart
+	const float PM_MASS_SCALE = 1024.f; // particle-mesh density units per particle, deposited as integers so any summation order gives the same grid
+}
+
+#endif
@@ -0,0 +1,221 @@
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#if defined(FHL_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	const std::size_t ARRAY_ALIGNMENT = 64u;
+
+	std::uint64_t alignUp(std::uint64_t _v) { return (_v + ARRAY_ALIGNMENT - 1u) / ARRAY_ALIGNMENT * ARRAY_ALIGNMENT; }
+
+	bool validate(const SnapshotHeader & _header, std::uint64_t _fileSize, const char * _path)
+	{
+		if (_header.magic != SnapshotHeader::Magic)
+		{
+			std::printf("%s is not a particle snapshot\n", _path);
+			return false;
+		}
+		if (_header.version != SnapshotHeader::Version)
+		{
+			std::printf("Unsupported snapshot version %u in %s\n", _header.version, _path);
+			return false;
+		}
+		if (_header.layout > std::uint32_t(StateLayout::Compact))
+		{
+			std::printf("Unknown state layout %u in %s\n", _header.layout, _path);
+			return false;
+		}
+		const StateLayout layout = StateLayout(_header.layout);
+		const std::uint64_t posSize = _header.particleCount * getPositionStride(layout);
+		const std::uint64_t velSize = _header.particleCount * getVelocityStride(layout);
+		if (_header.particleCount > _fileSize ||
+			_header.positionsOffset < sizeof(SnapshotHeader) || _header.velocitiesOffset < sizeof(SnapshotHeader) ||
+			_header.positionsOffset % ARRAY_ALIGNMENT || _header.velocitiesOffset % ARRAY_ALIGNMENT ||
+			_header.positionsOffset > _fileSize || posSize > _fileSize - _header.positionsOffset ||
+			_header.velocitiesOffset > _fileSize || velSize > _fileSize - _header.velocitiesOffset)
+		{
+			std::printf("Snapshot %s is truncated or corrupted\n", _path);
+			return false;
+		}
+		return true;
+	}
+
+	bool writePadded(std::FILE * _file, const void * _data, std::size_t _size)
+	{
+		static const unsigned char zeros[ARRAY_ALIGNMENT]{};
+		const std::size_t padding = std::size_t(alignUp(_size) - _size);
+		return std::fwrite(_data, 1u, _size, _file) == _size && std::fwrite(zeros, 1u, padding, _file) == padding;
+	}
+}
+
+bool writeSnapshot(const char * _path, const SnapshotInfo & _info, const void * _positions, const void * _velocities)
+{
+	const std::size_t posSize = _info.particleCount * getPositionStride(_info.layout);
+	const std::size_t velSize = _info.particleCount * getVelocityStride(_info.layout);
+
+	SnapshotHeader header{};
+	header.magic = SnapshotHeader::Magic;
+	header.version = SnapshotHeader::Version;
+	header.particleCount = _info.particleCount;
+	header.layout = std::uint32_t(_info.layout);
+	header.timestep = _info.timestep;
+	header.step = _info.step;
+	header.positionsOffset = alignUp(sizeof(SnapshotHeader));
+	header.velocitiesOffset = header.positionsOffset + alignUp(posSize);
+
+	std::FILE * file = std::fopen(_path, "wb");
+	if (!file)
+	{
+		std::printf("Could not open %s for writing\n", _path);
+		return false;
+	}
+	const bool ok =
+		writePadded(file, &header, sizeof(header)) &&
+		writePadded(file, _positions, posSize) &&
+		writePadded(file, _velocities, velSize);
+	if (std::fclose(file) || !ok)
+	{
+		std::printf("Could not write snapshot %s\n", _path);
+		return false;
+	}
+	return true;
+}
+
+SnapshotReader::SnapshotReader() :
+	m_info{},
+	m_positions{nullptr},
+	m_velocities{nullptr},
+	m_mapping{nullptr},
+	m_mappingSize{0u}
+{
+}
+
+SnapshotReader::~SnapshotReader()
+{
+	close();
+}
+
+bool SnapshotReader::open(const char * _path, Access _access)
+{
+	close();
+
+	SnapshotHeader header;
+	if (_access == Access::Map)
+	{
+#if defined(FHL_PLATFORM_WINDOWS)
+		HANDLE file = CreateFileA(_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			std::printf("Could not open snapshot %s\n", _path);
+			return false;
+		}
+		LARGE_INTEGER size{};
+		GetFileSizeEx(file, &size);
+		HANDLE mapping = size.QuadPart ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		CloseHandle(file);
+		if (mapping)
+		{
+			m_mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		m_mappingSize = std::size_t(size.QuadPart);
+#else
+		const int fd = ::open(_path, O_RDONLY);
+		if (fd < 0)
+		{
+			std::printf("Could not open snapshot %s\n", _path);
+			return false;
+		}
+		struct stat st{};
+		if (!fstat(fd, &st) && st.st_size > 0)
+		{
+			m_mappingSize = std::size_t(st.st_size);
+			m_mapping = mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (m_mapping == MAP_FAILED)
+				m_mapping = nullptr;
+		}
+		::close(fd);
+#endif
+		if (!m_mapping || m_mappingSize < sizeof(SnapshotHeader))
+		{
+			std::printf("Could not map snapshot %s\n", _path);
+			close();
+			return false;
+		}
+		std::memcpy(&header, m_mapping, sizeof(header));
+		if (!validate(header, m_mappingSize, _path))
+		{
+			close();
+			return false;
+		}
+		const unsigned char * base = static_cast<const unsigned char *>(m_mapping);
+		m_info = SnapshotInfo{std::size_t(header.particleCount), StateLayout(header.layout), header.timestep, header.step};
+		m_positions = base + header.positionsOffset;
+		m_velocities = base + header.velocitiesOffset;
+		return true;
+	}
+	else
+	{
+		std::FILE * file = std::fopen(_path, "rb");
+		if (!file)
+		{
+			std::printf("Could not open snapshot %s\n", _path);
+			return false;
+		}
+		bool ok = std::fread(&header, sizeof(header), 1u, file) == 1u && std::fseek(file, 0, SEEK_END) == 0;
+		const long fileSize = ok ? std::ftell(file) : -1L;
+		if (ok && fileSize < 0)
+		{
+			std::printf("Could not get the size of snapshot %s\n", _path);
+			ok = false;
+		}
+		ok = ok && validate(header, std::uint64_t(fileSize), _path);
+		if (ok)
+		{ // everything after the header up to the end of the later array
+			const StateLayout layout = StateLayout(header.layout);
+			const std::uint64_t end = (std::max)(header.positionsOffset + header.particleCount * getPositionStride(layout),
+				header.velocitiesOffset + header.particleCount * getVelocityStride(layout));
+			m_data.resize(std::size_t(end - sizeof(header)));
+			ok = std::fseek(file, long(sizeof(header)), SEEK_SET) == 0 && std::fread(m_data.data(), 1u, m_data.size(), file) == m_data.size();
+			if (!ok)
+				std::printf("Could not read snapshot %s\n", _path);
+		}
+		std::fclose(file);
+		if (!ok)
+		{
+			close();
+			return false;
+		}
+		m_info = SnapshotInfo{std::size_t(header.particleCount), StateLayout(header.layout), header.timestep, header.step};
+		m_positions = m_data.data() + (header.positionsOffset - sizeof(header));
+		m_velocities = m_data.data() + (header.velocitiesOffset - sizeof(header));
+		return true;
+	}
+}
+
+void SnapshotReader::close()
+{
+	if (m_mapping)
+	{
+#if defined(FHL_PLATFORM_WINDOWS)
+		UnmapViewOfFile(m_mapping);
+#else
+		munmap(m_mapping, m_mappingSize);
+#endif
+	}
+	m_mapping = nullptr;
+	m_mappingSize = 0u;
+	m_data = std::vector<unsigned char>();
+	m_info = SnapshotInfo{};
+	m_positions = m_velocities = nullptr;
+}
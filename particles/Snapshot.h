@@ -0,0 +1,74 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "StateLayout.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Particle state snapshot file, little-endian:
+ *  SnapshotHeader (64 bytes)
+ *  positions  - particleCount * getPositionStride(layout) bytes at positionsOffset
+ *  velocities - particleCount * getVelocityStride(layout) bytes at velocitiesOffset
+ * Both arrays are 64-byte aligned within the file, so they can be used directly from a mapping.
+ */
+struct SnapshotHeader
+{
+	enum : std::uint32_t { Magic = 0x504e5350u, Version = 1u }; // "PSNP"
+
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint64_t particleCount;
+	std::uint32_t layout; // StateLayout
+	float timestep; // fixed simulation step the state was advanced with, 0 - variable
+	std::uint64_t step; // number of simulation steps done
+	std::uint64_t positionsOffset;
+	std::uint64_t velocitiesOffset;
+	std::uint8_t reserved[16];
+};
+static_assert(sizeof(SnapshotHeader) == 64u, "SnapshotHeader must stay 64 bytes");
+
+struct SnapshotInfo
+{
+	std::size_t particleCount;
+	StateLayout layout;
+	float timestep;
+	std::uint64_t step;
+};
+
+/* Writes arrays in the given layout (e.g. contents of glGetNamedBufferSubData or ParticleStorage::storeState) */
+bool writeSnapshot(const char * _path, const SnapshotInfo & _info, const void * _positions, const void * _velocities);
+
+/* Read-only view of a snapshot file, either memory-mapped or read into memory as a whole */
+class SnapshotReader
+{
+public:
+	enum class Access { Map, Read };
+
+	SnapshotReader();
+	~SnapshotReader();
+
+	SnapshotReader(const SnapshotReader &) = delete;
+	SnapshotReader & operator=(const SnapshotReader &) = delete;
+
+	/* prints the reason and returns false if the file cannot be read or is not a valid snapshot */
+	bool open(const char * _path, Access _access);
+	void close();
+
+	const SnapshotInfo & getInfo() const { return m_info; }
+	const void * getPositions() const { return m_positions; }
+	const void * getVelocities() const { return m_velocities; }
+
+private:
+	SnapshotInfo m_info;
+	const void * m_positions;
+	const void * m_velocities;
+
+	void * m_mapping;
+	std::size_t m_mappingSize;
+	std::vector<unsigned char> m_data;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef STATE_LAYOUT_H
+#define STATE_LAYOUT_H
+
+#include <cstddef>
+
+/*
+ * Memory layout of the position/velocity buffers.
+ * Vec4    - std140 vec4 arrays, 32 bytes per particle (w unused)
+ * Compact - float3 positions and half-float velocities (4 halves, last unused), 20 bytes per particle
+ */
+enum class StateLayout { Vec4, Compact };
+
+inline std::size_t getPositionStride(StateLayout _layout) { return _layout == StateLayout::Compact ? 3u * sizeof(float) : 4u * sizeof(float); }
+inline std::size_t getVelocityStride(StateLayout _layout) { return _layout == StateLayout::Compact ? 4u * sizeof(unsigned short) : 4u * sizeof(float); }
+
+/* #defines selecting the layout in shaders using state_access.glsl */
+inline const char * getStateLayoutDefines(StateLayout _layout) { return _layout == StateLayout::Compact ? "#define COMPACT_STATE\n" : ""; }
+
+#endif
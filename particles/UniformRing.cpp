@@ -0,0 +1,133 @@
+#include "UniformRing.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+UniformRing::UniformRing(const UniformUsage & _frame, unsigned _regions) :
+	m_buffer{},
+	m_mapping{},
+	m_regionSize{},
+	m_regions{std::min<unsigned>(std::max(_regions, 2u), MAX_REGIONS)},
+	m_alignment{},
+	m_region{0u},
+	m_offset{0},
+	m_fences{},
+	m_written{},
+	m_stalls{0u}
+{
+	GLint alignment{};
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	m_alignment = std::max<GLsizeiptr>(alignment, 16);
+	// every block starts at an aligned offset, as do regions
+	m_regionSize = (_frame.bytes + GLsizeiptr(_frame.blocks) * m_alignment + m_alignment - 1) / m_alignment * m_alignment;
+	createBuffer();
+}
+
+UniformRing::~UniformRing()
+{
+	for (GLsync fence : m_fences)
+		if (fence)
+			glDeleteSync(fence);
+	for (const RetiredBuffer & retired : m_retired)
+	{
+		if (retired.fence)
+			glDeleteSync(retired.fence);
+		glUnmapNamedBuffer(retired.buffer);
+		glDeleteBuffers(1, &retired.buffer);
+	}
+	glUnmapNamedBuffer(m_buffer);
+	glDeleteBuffers(1, &m_buffer);
+}
+
+UniformRing::Block UniformRing::allocate(GLsizeiptr _size)
+{
+	assert(_size <= m_regionSize && "uniform block larger than a region of the ring");
+	if (m_offset + _size > m_regionSize)
+	{
+		if (m_written[(m_region + 1u) % m_regions])
+			grow();
+		else
+			nextRegion();
+	}
+	m_written[m_region] = true;
+	const GLintptr offset = m_region * m_regionSize + m_offset;
+	m_offset += (_size + m_alignment - 1) / m_alignment * m_alignment;
+	return Block{m_mapping + offset, m_buffer, offset, _size};
+}
+
+void UniformRing::bind(GLuint _index, const Block & _block) const
+{
+	glBindBufferRange(GL_UNIFORM_BUFFER, _index, _block.buffer, _block.offset, _block.size);
+}
+
+void UniformRing::endFrame()
+{
+	// only now all commands reading this frame's blocks are issued
+	for (unsigned i = 0u; i < m_regions; ++i)
+	{
+		if (!m_written[i])
+			continue;
+		if (m_fences[i])
+			glDeleteSync(m_fences[i]);
+		m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_written[i] = false;
+	}
+	for (RetiredBuffer & retired : m_retired)
+		if (!retired.fence)
+			retired.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), [](const RetiredBuffer & _retired) {
+		if (glClientWaitSync(_retired.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+			return false;
+		glDeleteSync(_retired.fence);
+		glUnmapNamedBuffer(_retired.buffer);
+		glDeleteBuffers(1, &_retired.buffer);
+		return true;
+	}), m_retired.end());
+	nextRegion();
+}
+
+void UniformRing::createBuffer()
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glCreateBuffers(1, &m_buffer);
+	glNamedBufferStorage(m_buffer, m_regionSize * m_regions, nullptr, flags);
+	m_mapping = static_cast<unsigned char *>(glMapNamedBufferRange(m_buffer, 0, m_regionSize * m_regions, flags));
+}
+
+void UniformRing::nextRegion()
+{
+	m_region = (m_region + 1u) % m_regions;
+	m_offset = 0;
+	GLsync & next = m_fences[m_region];
+	if (!next)
+		return;
+	GLenum status = glClientWaitSync(next, 0, 0);
+	if (status == GL_TIMEOUT_EXPIRED)
+	{
+		++m_stalls;
+		do
+			status = glClientWaitSync(next, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000u);
+		while (status == GL_TIMEOUT_EXPIRED);
+	}
+	glDeleteSync(next);
+	next = nullptr;
+}
+
+void UniformRing::grow()
+{
+	// blocks of this frame in the old buffer may still be bound; its fence at the end of the frame follows all commands reading it
+	m_retired.push_back(RetiredBuffer{m_buffer, nullptr});
+	for (unsigned i = 0u; i < m_regions; ++i)
+	{
+		if (m_fences[i])
+			glDeleteSync(m_fences[i]);
+		m_fences[i] = nullptr;
+		m_written[i] = false;
+	}
+	m_regionSize *= 2;
+	createBuffer();
+	m_region = 0u;
+	m_offset = 0;
+	std::printf("Uniform parameters of a frame outgrew their ring, regions grown to %lld bytes\n", (long long)m_regionSize);
+}
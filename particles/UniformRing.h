@@ -0,0 +1,90 @@
+#ifndef UNIFORM_RING_H
+#define UNIFORM_RING_H
+
+#include "gl/flextGL.h"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/* number and total size of the uniform blocks some work pushes, to size a UniformRing for the worst frame */
+struct UniformUsage
+{
+	std::size_t blocks;
+	GLsizeiptr bytes;
+};
+inline UniformUsage operator+(const UniformUsage & _a, const UniformUsage & _b) { return UniformUsage{_a.blocks + _b.blocks, _a.bytes + _b.bytes}; }
+inline UniformUsage operator*(const UniformUsage & _usage, std::size_t _times) { return UniformUsage{_usage.blocks * _times, _usage.bytes * GLsizeiptr(_times)}; }
+
+/*
+ * Persistently mapped, coherent uniform buffer split into regions written on consecutive frames.
+ * Parameters are copied once into the region of the current frame and bound with glBindBufferRange;
+ * endFrame() fences the regions the frame wrote and moves on to the next one, waiting only if the GPU is still reading it
+ * (i.e. the CPU is more than _regions - 1 frames ahead). A frame that fills its region continues in the next one.
+ * Should it reach a region it wrote itself, whose blocks later commands of the frame may still read, the ring moves
+ * to a new buffer with twice the region size instead and deletes the old one once the GPU is done with it,
+ * so regions are sized for the most a frame pushes, _frame.
+ */
+class UniformRing
+{
+public:
+	struct Block
+	{
+		void * data;
+		GLuint buffer;
+		GLintptr offset;
+		GLsizeiptr size;
+	};
+
+	explicit UniformRing(const UniformUsage & _frame, unsigned _regions = 3u);
+	~UniformRing();
+
+	UniformRing(const UniformRing &) = delete;
+	UniformRing & operator=(const UniformRing &) = delete;
+
+	/* space for _size bytes aligned to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, _size must not exceed the region size */
+	Block allocate(GLsizeiptr _size);
+	/* copies _value into a new block and binds it to uniform block binding _index */
+	template<typename T>
+	void push(GLuint _index, const T & _value)
+	{
+		const Block block = allocate(sizeof(T));
+		std::memcpy(block.data, &_value, sizeof(T));
+		bind(_index, block);
+	}
+	void bind(GLuint _index, const Block & _block) const;
+
+	void endFrame();
+
+	/* times the CPU had to wait for the GPU to release a region */
+	std::size_t getStalls() const { return m_stalls; }
+	GLsizeiptr getRegionSize() const { return m_regionSize; }
+
+private:
+	void createBuffer();
+	void nextRegion();
+	void grow();
+
+	enum { MAX_REGIONS = 4 };
+
+	// buffers replaced by grow(), fenced at the end of the frame that replaced them
+	struct RetiredBuffer
+	{
+		GLuint buffer;
+		GLsync fence;
+	};
+
+	GLuint m_buffer;
+	unsigned char * m_mapping;
+	GLsizeiptr m_regionSize;
+	unsigned m_regions;
+	GLsizeiptr m_alignment;
+	unsigned m_region;
+	GLsizeiptr m_offset; // within the current region
+	GLsync m_fences[MAX_REGIONS];
+	bool m_written[MAX_REGIONS]; // by the current frame, fenced at its end
+	std::size_t m_stalls;
+	std::vector<RetiredBuffer> m_retired;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef UPDATE_KERNELS_H
+#define UPDATE_KERNELS_H
+
+#include "ParticleStreams.h"
+
+#include <cstddef>
+
+/*
+ * Declarations shared by the CPU update kernels of every instruction set. The instruction set specific translation units
+ * include only this, SimulationConstants.h and intrinsics: an inline function of another header used there would be compiled
+ * with their instruction set too, and the linker may pick that copy for every caller, also on CPUs without it.
+ */
+
+/* SimulationParams of one system range as plain floats */
+struct UpdateParams
+{
+	float dt;
+	bool attractorActive;
+	float attractorPosition[3];
+	float attractorScale;
+};
+
+using UpdateKernel = void(*)(const ParticleStreams & _streams, const UpdateParams & _params, std::size_t _begin, std::size_t _end);
+
+namespace kernels
+{
+	void updateScalar(const ParticleStreams & _streams, const UpdateParams & _params, std::size_t _begin, std::size_t _end);
+	void updateSse(const ParticleStreams & _streams, const UpdateParams & _params, std::size_t _begin, std::size_t _end);
+	void updateAvx2(const ParticleStreams & _streams, const UpdateParams & _params, std::size_t _begin, std::size_t _end);
+	void updateAvx512(const ParticleStreams & _streams, const UpdateParams & _params, std::size_t _begin, std::size_t _end);
+
+	/* false if the translation unit was built without the instruction set (the kernel then forwards to updateScalar) */
+	extern const bool sseCompiled;
+	extern const bool avx2Compiled;
+	extern const bool avx512Compiled;
+}
+
+#endif
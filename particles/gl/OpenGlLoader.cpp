@@ -14,6 +14,9 @@
 #else
 	#include <dlfcn.h>
 	#include <GL/glx.h>
+	#if defined(FHL_USE_EGL)
+		#include <EGL/egl.h>
+	#endif
 #endif
 
 namespace fhl { namespace impl {
@@ -64,7 +67,11 @@ namespace fhl { namespace impl {
 
 	auto OpenGlLoader::load(const char * _name) -> fptr_t
 	{
-		return glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(name));
+#if defined(FHL_USE_EGL)
+		if (eglGetCurrentContext() != EGL_NO_CONTEXT) // headless context
+			return eglGetProcAddress(_name);
+#endif
+		return glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(_name));
 	}
 #endif
 
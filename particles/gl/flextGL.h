@@ -33,7 +33,10 @@
 extern "C" {
 #endif
 
+/* resolves all entry points now */
 void flextGLInit();
+/* makes every entry point resolve itself on its first call */
+void flextGLInitLazy();
 
 #define FLEXTGL_EXPORT
 
@@ -2,8 +2,45 @@
 
 #include "OpenGlLoader.h"
 
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    fhl::impl::OpenGlLoader & getLoader() {
+        static fhl::impl::OpenGlLoader loader;
+        return loader;
+    }
+
+    /* Function pointer starting as a trampoline that resolves the real entry point and replaces itself on first call */
+    template<typename Fn, Fn * Slot>
+    struct LazyEntry;
+
+    template<typename R, typename... Args, R(APIENTRY ** Slot)(Args...)>
+    struct LazyEntry<R(APIENTRY *)(Args...), Slot> {
+        static const char * name;
+
+        static void bind(const char * _name) {
+            name = _name;
+            *Slot = &call;
+        }
+
+        static R APIENTRY call(Args... _args) {
+            const auto fn = reinterpret_cast<R(APIENTRY *)(Args...)>(getLoader().load(name));
+            if (!fn) {
+                std::fprintf(stderr, "%s is not supported by the OpenGL implementation\n", name);
+                std::abort();
+            }
+            *Slot = fn;
+            return fn(_args...);
+        }
+    };
+
+    template<typename R, typename... Args, R(APIENTRY ** Slot)(Args...)>
+    const char * LazyEntry<R(APIENTRY *)(Args...), Slot>::name = nullptr;
+}
+
 void flextGLInit() {
-    fhl::impl::OpenGlLoader loader;
+    fhl::impl::OpenGlLoader & loader = getLoader();
 
     /* GL_VERSION_1_2 */
     flextglCopyTexSubImage3D = reinterpret_cast<void(APIENTRY*)(GLenum, GLint, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei)>(loader.load("glCopyTexSubImage3D"));
@@ -628,4 +665,631 @@ void flextGLInit() {
     flextglVertexArrayElementBuffer = reinterpret_cast<void(APIENTRY*)(GLuint, GLuint)>(loader.load("glVertexArrayElementBuffer"));
     flextglVertexArrayVertexBuffer = reinterpret_cast<void(APIENTRY*)(GLuint, GLuint, GLuint, GLintptr, GLsizei)>(loader.load("glVertexArrayVertexBuffer"));
     flextglVertexArrayVertexBuffers = reinterpret_cast<void(APIENTRY*)(GLuint, GLuint, GLsizei, const GLuint *, const GLintptr *, const GLsizei *)>(loader.load("glVertexArrayVertexBuffers"));
+}
+
+void flextGLInitLazy() {
+
+    /* GL_VERSION_1_2 */
+    LazyEntry<decltype(flextglCopyTexSubImage3D), &flextglCopyTexSubImage3D>::bind("glCopyTexSubImage3D");
+    LazyEntry<decltype(flextglDrawRangeElements), &flextglDrawRangeElements>::bind("glDrawRangeElements");
+    LazyEntry<decltype(flextglTexImage3D), &flextglTexImage3D>::bind("glTexImage3D");
+    LazyEntry<decltype(flextglTexSubImage3D), &flextglTexSubImage3D>::bind("glTexSubImage3D");
+
+    /* GL_VERSION_1_3 */
+    LazyEntry<decltype(flextglActiveTexture), &flextglActiveTexture>::bind("glActiveTexture");
+    LazyEntry<decltype(flextglCompressedTexImage1D), &flextglCompressedTexImage1D>::bind("glCompressedTexImage1D");
+    LazyEntry<decltype(flextglCompressedTexImage2D), &flextglCompressedTexImage2D>::bind("glCompressedTexImage2D");
+    LazyEntry<decltype(flextglCompressedTexImage3D), &flextglCompressedTexImage3D>::bind("glCompressedTexImage3D");
+    LazyEntry<decltype(flextglCompressedTexSubImage1D), &flextglCompressedTexSubImage1D>::bind("glCompressedTexSubImage1D");
+    LazyEntry<decltype(flextglCompressedTexSubImage2D), &flextglCompressedTexSubImage2D>::bind("glCompressedTexSubImage2D");
+    LazyEntry<decltype(flextglCompressedTexSubImage3D), &flextglCompressedTexSubImage3D>::bind("glCompressedTexSubImage3D");
+    LazyEntry<decltype(flextglGetCompressedTexImage), &flextglGetCompressedTexImage>::bind("glGetCompressedTexImage");
+    LazyEntry<decltype(flextglSampleCoverage), &flextglSampleCoverage>::bind("glSampleCoverage");
+
+    /* GL_VERSION_1_4 */
+    LazyEntry<decltype(flextglBlendColor), &flextglBlendColor>::bind("glBlendColor");
+    LazyEntry<decltype(flextglBlendEquation), &flextglBlendEquation>::bind("glBlendEquation");
+    LazyEntry<decltype(flextglBlendFuncSeparate), &flextglBlendFuncSeparate>::bind("glBlendFuncSeparate");
+    LazyEntry<decltype(flextglMultiDrawArrays), &flextglMultiDrawArrays>::bind("glMultiDrawArrays");
+    LazyEntry<decltype(flextglMultiDrawElements), &flextglMultiDrawElements>::bind("glMultiDrawElements");
+    LazyEntry<decltype(flextglPointParameterf), &flextglPointParameterf>::bind("glPointParameterf");
+    LazyEntry<decltype(flextglPointParameterfv), &flextglPointParameterfv>::bind("glPointParameterfv");
+    LazyEntry<decltype(flextglPointParameteri), &flextglPointParameteri>::bind("glPointParameteri");
+    LazyEntry<decltype(flextglPointParameteriv), &flextglPointParameteriv>::bind("glPointParameteriv");
+
+    /* GL_VERSION_1_5 */
+    LazyEntry<decltype(flextglBeginQuery), &flextglBeginQuery>::bind("glBeginQuery");
+    LazyEntry<decltype(flextglBindBuffer), &flextglBindBuffer>::bind("glBindBuffer");
+    LazyEntry<decltype(flextglBufferData), &flextglBufferData>::bind("glBufferData");
+    LazyEntry<decltype(flextglBufferSubData), &flextglBufferSubData>::bind("glBufferSubData");
+    LazyEntry<decltype(flextglDeleteBuffers), &flextglDeleteBuffers>::bind("glDeleteBuffers");
+    LazyEntry<decltype(flextglDeleteQueries), &flextglDeleteQueries>::bind("glDeleteQueries");
+    LazyEntry<decltype(flextglEndQuery), &flextglEndQuery>::bind("glEndQuery");
+    LazyEntry<decltype(flextglGenBuffers), &flextglGenBuffers>::bind("glGenBuffers");
+    LazyEntry<decltype(flextglGenQueries), &flextglGenQueries>::bind("glGenQueries");
+    LazyEntry<decltype(flextglGetBufferParameteriv), &flextglGetBufferParameteriv>::bind("glGetBufferParameteriv");
+    LazyEntry<decltype(flextglGetBufferPointerv), &flextglGetBufferPointerv>::bind("glGetBufferPointerv");
+    LazyEntry<decltype(flextglGetBufferSubData), &flextglGetBufferSubData>::bind("glGetBufferSubData");
+    LazyEntry<decltype(flextglGetQueryObjectiv), &flextglGetQueryObjectiv>::bind("glGetQueryObjectiv");
+    LazyEntry<decltype(flextglGetQueryObjectuiv), &flextglGetQueryObjectuiv>::bind("glGetQueryObjectuiv");
+    LazyEntry<decltype(flextglGetQueryiv), &flextglGetQueryiv>::bind("glGetQueryiv");
+    LazyEntry<decltype(flextglIsBuffer), &flextglIsBuffer>::bind("glIsBuffer");
+    LazyEntry<decltype(flextglIsQuery), &flextglIsQuery>::bind("glIsQuery");
+    LazyEntry<decltype(flextglMapBuffer), &flextglMapBuffer>::bind("glMapBuffer");
+    LazyEntry<decltype(flextglUnmapBuffer), &flextglUnmapBuffer>::bind("glUnmapBuffer");
+
+    /* GL_VERSION_2_0 */
+    LazyEntry<decltype(flextglAttachShader), &flextglAttachShader>::bind("glAttachShader");
+    LazyEntry<decltype(flextglBindAttribLocation), &flextglBindAttribLocation>::bind("glBindAttribLocation");
+    LazyEntry<decltype(flextglBlendEquationSeparate), &flextglBlendEquationSeparate>::bind("glBlendEquationSeparate");
+    LazyEntry<decltype(flextglCompileShader), &flextglCompileShader>::bind("glCompileShader");
+    LazyEntry<decltype(flextglCreateProgram), &flextglCreateProgram>::bind("glCreateProgram");
+    LazyEntry<decltype(flextglCreateShader), &flextglCreateShader>::bind("glCreateShader");
+    LazyEntry<decltype(flextglDeleteProgram), &flextglDeleteProgram>::bind("glDeleteProgram");
+    LazyEntry<decltype(flextglDeleteShader), &flextglDeleteShader>::bind("glDeleteShader");
+    LazyEntry<decltype(flextglDetachShader), &flextglDetachShader>::bind("glDetachShader");
+    LazyEntry<decltype(flextglDisableVertexAttribArray), &flextglDisableVertexAttribArray>::bind("glDisableVertexAttribArray");
+    LazyEntry<decltype(flextglDrawBuffers), &flextglDrawBuffers>::bind("glDrawBuffers");
+    LazyEntry<decltype(flextglEnableVertexAttribArray), &flextglEnableVertexAttribArray>::bind("glEnableVertexAttribArray");
+    LazyEntry<decltype(flextglGetActiveAttrib), &flextglGetActiveAttrib>::bind("glGetActiveAttrib");
+    LazyEntry<decltype(flextglGetActiveUniform), &flextglGetActiveUniform>::bind("glGetActiveUniform");
+    LazyEntry<decltype(flextglGetAttachedShaders), &flextglGetAttachedShaders>::bind("glGetAttachedShaders");
+    LazyEntry<decltype(flextglGetAttribLocation), &flextglGetAttribLocation>::bind("glGetAttribLocation");
+    LazyEntry<decltype(flextglGetProgramInfoLog), &flextglGetProgramInfoLog>::bind("glGetProgramInfoLog");
+    LazyEntry<decltype(flextglGetProgramiv), &flextglGetProgramiv>::bind("glGetProgramiv");
+    LazyEntry<decltype(flextglGetShaderInfoLog), &flextglGetShaderInfoLog>::bind("glGetShaderInfoLog");
+    LazyEntry<decltype(flextglGetShaderSource), &flextglGetShaderSource>::bind("glGetShaderSource");
+    LazyEntry<decltype(flextglGetShaderiv), &flextglGetShaderiv>::bind("glGetShaderiv");
+    LazyEntry<decltype(flextglGetUniformLocation), &flextglGetUniformLocation>::bind("glGetUniformLocation");
+    LazyEntry<decltype(flextglGetUniformfv), &flextglGetUniformfv>::bind("glGetUniformfv");
+    LazyEntry<decltype(flextglGetUniformiv), &flextglGetUniformiv>::bind("glGetUniformiv");
+    LazyEntry<decltype(flextglGetVertexAttribPointerv), &flextglGetVertexAttribPointerv>::bind("glGetVertexAttribPointerv");
+    LazyEntry<decltype(flextglGetVertexAttribdv), &flextglGetVertexAttribdv>::bind("glGetVertexAttribdv");
+    LazyEntry<decltype(flextglGetVertexAttribfv), &flextglGetVertexAttribfv>::bind("glGetVertexAttribfv");
+    LazyEntry<decltype(flextglGetVertexAttribiv), &flextglGetVertexAttribiv>::bind("glGetVertexAttribiv");
+    LazyEntry<decltype(flextglIsProgram), &flextglIsProgram>::bind("glIsProgram");
+    LazyEntry<decltype(flextglIsShader), &flextglIsShader>::bind("glIsShader");
+    LazyEntry<decltype(flextglLinkProgram), &flextglLinkProgram>::bind("glLinkProgram");
+    LazyEntry<decltype(flextglShaderSource), &flextglShaderSource>::bind("glShaderSource");
+    LazyEntry<decltype(flextglStencilFuncSeparate), &flextglStencilFuncSeparate>::bind("glStencilFuncSeparate");
+    LazyEntry<decltype(flextglStencilMaskSeparate), &flextglStencilMaskSeparate>::bind("glStencilMaskSeparate");
+    LazyEntry<decltype(flextglStencilOpSeparate), &flextglStencilOpSeparate>::bind("glStencilOpSeparate");
+    LazyEntry<decltype(flextglUniform1f), &flextglUniform1f>::bind("glUniform1f");
+    LazyEntry<decltype(flextglUniform1fv), &flextglUniform1fv>::bind("glUniform1fv");
+    LazyEntry<decltype(flextglUniform1i), &flextglUniform1i>::bind("glUniform1i");
+    LazyEntry<decltype(flextglUniform1iv), &flextglUniform1iv>::bind("glUniform1iv");
+    LazyEntry<decltype(flextglUniform2f), &flextglUniform2f>::bind("glUniform2f");
+    LazyEntry<decltype(flextglUniform2fv), &flextglUniform2fv>::bind("glUniform2fv");
+    LazyEntry<decltype(flextglUniform2i), &flextglUniform2i>::bind("glUniform2i");
+    LazyEntry<decltype(flextglUniform2iv), &flextglUniform2iv>::bind("glUniform2iv");
+    LazyEntry<decltype(flextglUniform3f), &flextglUniform3f>::bind("glUniform3f");
+    LazyEntry<decltype(flextglUniform3fv), &flextglUniform3fv>::bind("glUniform3fv");
+    LazyEntry<decltype(flextglUniform3i), &flextglUniform3i>::bind("glUniform3i");
+    LazyEntry<decltype(flextglUniform3iv), &flextglUniform3iv>::bind("glUniform3iv");
+    LazyEntry<decltype(flextglUniform4f), &flextglUniform4f>::bind("glUniform4f");
+    LazyEntry<decltype(flextglUniform4fv), &flextglUniform4fv>::bind("glUniform4fv");
+    LazyEntry<decltype(flextglUniform4i), &flextglUniform4i>::bind("glUniform4i");
+    LazyEntry<decltype(flextglUniform4iv), &flextglUniform4iv>::bind("glUniform4iv");
+    LazyEntry<decltype(flextglUniformMatrix2fv), &flextglUniformMatrix2fv>::bind("glUniformMatrix2fv");
+    LazyEntry<decltype(flextglUniformMatrix3fv), &flextglUniformMatrix3fv>::bind("glUniformMatrix3fv");
+    LazyEntry<decltype(flextglUniformMatrix4fv), &flextglUniformMatrix4fv>::bind("glUniformMatrix4fv");
+    LazyEntry<decltype(flextglUseProgram), &flextglUseProgram>::bind("glUseProgram");
+    LazyEntry<decltype(flextglValidateProgram), &flextglValidateProgram>::bind("glValidateProgram");
+    LazyEntry<decltype(flextglVertexAttrib1d), &flextglVertexAttrib1d>::bind("glVertexAttrib1d");
+    LazyEntry<decltype(flextglVertexAttrib1dv), &flextglVertexAttrib1dv>::bind("glVertexAttrib1dv");
+    LazyEntry<decltype(flextglVertexAttrib1f), &flextglVertexAttrib1f>::bind("glVertexAttrib1f");
+    LazyEntry<decltype(flextglVertexAttrib1fv), &flextglVertexAttrib1fv>::bind("glVertexAttrib1fv");
+    LazyEntry<decltype(flextglVertexAttrib1s), &flextglVertexAttrib1s>::bind("glVertexAttrib1s");
+    LazyEntry<decltype(flextglVertexAttrib1sv), &flextglVertexAttrib1sv>::bind("glVertexAttrib1sv");
+    LazyEntry<decltype(flextglVertexAttrib2d), &flextglVertexAttrib2d>::bind("glVertexAttrib2d");
+    LazyEntry<decltype(flextglVertexAttrib2dv), &flextglVertexAttrib2dv>::bind("glVertexAttrib2dv");
+    LazyEntry<decltype(flextglVertexAttrib2f), &flextglVertexAttrib2f>::bind("glVertexAttrib2f");
+    LazyEntry<decltype(flextglVertexAttrib2fv), &flextglVertexAttrib2fv>::bind("glVertexAttrib2fv");
+    LazyEntry<decltype(flextglVertexAttrib2s), &flextglVertexAttrib2s>::bind("glVertexAttrib2s");
+    LazyEntry<decltype(flextglVertexAttrib2sv), &flextglVertexAttrib2sv>::bind("glVertexAttrib2sv");
+    LazyEntry<decltype(flextglVertexAttrib3d), &flextglVertexAttrib3d>::bind("glVertexAttrib3d");
+    LazyEntry<decltype(flextglVertexAttrib3dv), &flextglVertexAttrib3dv>::bind("glVertexAttrib3dv");
+    LazyEntry<decltype(flextglVertexAttrib3f), &flextglVertexAttrib3f>::bind("glVertexAttrib3f");
+    LazyEntry<decltype(flextglVertexAttrib3fv), &flextglVertexAttrib3fv>::bind("glVertexAttrib3fv");
+    LazyEntry<decltype(flextglVertexAttrib3s), &flextglVertexAttrib3s>::bind("glVertexAttrib3s");
+    LazyEntry<decltype(flextglVertexAttrib3sv), &flextglVertexAttrib3sv>::bind("glVertexAttrib3sv");
+    LazyEntry<decltype(flextglVertexAttrib4Nbv), &flextglVertexAttrib4Nbv>::bind("glVertexAttrib4Nbv");
+    LazyEntry<decltype(flextglVertexAttrib4Niv), &flextglVertexAttrib4Niv>::bind("glVertexAttrib4Niv");
+    LazyEntry<decltype(flextglVertexAttrib4Nsv), &flextglVertexAttrib4Nsv>::bind("glVertexAttrib4Nsv");
+    LazyEntry<decltype(flextglVertexAttrib4Nub), &flextglVertexAttrib4Nub>::bind("glVertexAttrib4Nub");
+    LazyEntry<decltype(flextglVertexAttrib4Nubv), &flextglVertexAttrib4Nubv>::bind("glVertexAttrib4Nubv");
+    LazyEntry<decltype(flextglVertexAttrib4Nuiv), &flextglVertexAttrib4Nuiv>::bind("glVertexAttrib4Nuiv");
+    LazyEntry<decltype(flextglVertexAttrib4Nusv), &flextglVertexAttrib4Nusv>::bind("glVertexAttrib4Nusv");
+    LazyEntry<decltype(flextglVertexAttrib4bv), &flextglVertexAttrib4bv>::bind("glVertexAttrib4bv");
+    LazyEntry<decltype(flextglVertexAttrib4d), &flextglVertexAttrib4d>::bind("glVertexAttrib4d");
+    LazyEntry<decltype(flextglVertexAttrib4dv), &flextglVertexAttrib4dv>::bind("glVertexAttrib4dv");
+    LazyEntry<decltype(flextglVertexAttrib4f), &flextglVertexAttrib4f>::bind("glVertexAttrib4f");
+    LazyEntry<decltype(flextglVertexAttrib4fv), &flextglVertexAttrib4fv>::bind("glVertexAttrib4fv");
+    LazyEntry<decltype(flextglVertexAttrib4iv), &flextglVertexAttrib4iv>::bind("glVertexAttrib4iv");
+    LazyEntry<decltype(flextglVertexAttrib4s), &flextglVertexAttrib4s>::bind("glVertexAttrib4s");
+    LazyEntry<decltype(flextglVertexAttrib4sv), &flextglVertexAttrib4sv>::bind("glVertexAttrib4sv");
+    LazyEntry<decltype(flextglVertexAttrib4ubv), &flextglVertexAttrib4ubv>::bind("glVertexAttrib4ubv");
+    LazyEntry<decltype(flextglVertexAttrib4uiv), &flextglVertexAttrib4uiv>::bind("glVertexAttrib4uiv");
+    LazyEntry<decltype(flextglVertexAttrib4usv), &flextglVertexAttrib4usv>::bind("glVertexAttrib4usv");
+    LazyEntry<decltype(flextglVertexAttribPointer), &flextglVertexAttribPointer>::bind("glVertexAttribPointer");
+
+    /* GL_VERSION_2_1 */
+    LazyEntry<decltype(flextglUniformMatrix2x3fv), &flextglUniformMatrix2x3fv>::bind("glUniformMatrix2x3fv");
+    LazyEntry<decltype(flextglUniformMatrix2x4fv), &flextglUniformMatrix2x4fv>::bind("glUniformMatrix2x4fv");
+    LazyEntry<decltype(flextglUniformMatrix3x2fv), &flextglUniformMatrix3x2fv>::bind("glUniformMatrix3x2fv");
+    LazyEntry<decltype(flextglUniformMatrix3x4fv), &flextglUniformMatrix3x4fv>::bind("glUniformMatrix3x4fv");
+    LazyEntry<decltype(flextglUniformMatrix4x2fv), &flextglUniformMatrix4x2fv>::bind("glUniformMatrix4x2fv");
+    LazyEntry<decltype(flextglUniformMatrix4x3fv), &flextglUniformMatrix4x3fv>::bind("glUniformMatrix4x3fv");
+
+    /* GL_VERSION_3_0 */
+    LazyEntry<decltype(flextglBeginConditionalRender), &flextglBeginConditionalRender>::bind("glBeginConditionalRender");
+    LazyEntry<decltype(flextglBeginTransformFeedback), &flextglBeginTransformFeedback>::bind("glBeginTransformFeedback");
+    LazyEntry<decltype(flextglBindBufferBase), &flextglBindBufferBase>::bind("glBindBufferBase");
+    LazyEntry<decltype(flextglBindBufferRange), &flextglBindBufferRange>::bind("glBindBufferRange");
+    LazyEntry<decltype(flextglBindFragDataLocation), &flextglBindFragDataLocation>::bind("glBindFragDataLocation");
+    LazyEntry<decltype(flextglBindFramebuffer), &flextglBindFramebuffer>::bind("glBindFramebuffer");
+    LazyEntry<decltype(flextglBindRenderbuffer), &flextglBindRenderbuffer>::bind("glBindRenderbuffer");
+    LazyEntry<decltype(flextglBindVertexArray), &flextglBindVertexArray>::bind("glBindVertexArray");
+    LazyEntry<decltype(flextglBlitFramebuffer), &flextglBlitFramebuffer>::bind("glBlitFramebuffer");
+    LazyEntry<decltype(flextglCheckFramebufferStatus), &flextglCheckFramebufferStatus>::bind("glCheckFramebufferStatus");
+    LazyEntry<decltype(flextglClampColor), &flextglClampColor>::bind("glClampColor");
+    LazyEntry<decltype(flextglClearBufferfi), &flextglClearBufferfi>::bind("glClearBufferfi");
+    LazyEntry<decltype(flextglClearBufferfv), &flextglClearBufferfv>::bind("glClearBufferfv");
+    LazyEntry<decltype(flextglClearBufferiv), &flextglClearBufferiv>::bind("glClearBufferiv");
+    LazyEntry<decltype(flextglClearBufferuiv), &flextglClearBufferuiv>::bind("glClearBufferuiv");
+    LazyEntry<decltype(flextglColorMaski), &flextglColorMaski>::bind("glColorMaski");
+    LazyEntry<decltype(flextglDeleteFramebuffers), &flextglDeleteFramebuffers>::bind("glDeleteFramebuffers");
+    LazyEntry<decltype(flextglDeleteRenderbuffers), &flextglDeleteRenderbuffers>::bind("glDeleteRenderbuffers");
+    LazyEntry<decltype(flextglDeleteVertexArrays), &flextglDeleteVertexArrays>::bind("glDeleteVertexArrays");
+    LazyEntry<decltype(flextglDisablei), &flextglDisablei>::bind("glDisablei");
+    LazyEntry<decltype(flextglEnablei), &flextglEnablei>::bind("glEnablei");
+    LazyEntry<decltype(flextglEndConditionalRender), &flextglEndConditionalRender>::bind("glEndConditionalRender");
+    LazyEntry<decltype(flextglEndTransformFeedback), &flextglEndTransformFeedback>::bind("glEndTransformFeedback");
+    LazyEntry<decltype(flextglFlushMappedBufferRange), &flextglFlushMappedBufferRange>::bind("glFlushMappedBufferRange");
+    LazyEntry<decltype(flextglFramebufferRenderbuffer), &flextglFramebufferRenderbuffer>::bind("glFramebufferRenderbuffer");
+    LazyEntry<decltype(flextglFramebufferTexture1D), &flextglFramebufferTexture1D>::bind("glFramebufferTexture1D");
+    LazyEntry<decltype(flextglFramebufferTexture2D), &flextglFramebufferTexture2D>::bind("glFramebufferTexture2D");
+    LazyEntry<decltype(flextglFramebufferTexture3D), &flextglFramebufferTexture3D>::bind("glFramebufferTexture3D");
+    LazyEntry<decltype(flextglFramebufferTextureLayer), &flextglFramebufferTextureLayer>::bind("glFramebufferTextureLayer");
+    LazyEntry<decltype(flextglGenFramebuffers), &flextglGenFramebuffers>::bind("glGenFramebuffers");
+    LazyEntry<decltype(flextglGenRenderbuffers), &flextglGenRenderbuffers>::bind("glGenRenderbuffers");
+    LazyEntry<decltype(flextglGenVertexArrays), &flextglGenVertexArrays>::bind("glGenVertexArrays");
+    LazyEntry<decltype(flextglGenerateMipmap), &flextglGenerateMipmap>::bind("glGenerateMipmap");
+    LazyEntry<decltype(flextglGetBooleani_v), &flextglGetBooleani_v>::bind("glGetBooleani_v");
+    LazyEntry<decltype(flextglGetFragDataLocation), &flextglGetFragDataLocation>::bind("glGetFragDataLocation");
+    LazyEntry<decltype(flextglGetFramebufferAttachmentParameteriv), &flextglGetFramebufferAttachmentParameteriv>::bind("glGetFramebufferAttachmentParameteriv");
+    LazyEntry<decltype(flextglGetIntegeri_v), &flextglGetIntegeri_v>::bind("glGetIntegeri_v");
+    LazyEntry<decltype(flextglGetRenderbufferParameteriv), &flextglGetRenderbufferParameteriv>::bind("glGetRenderbufferParameteriv");
+    LazyEntry<decltype(flextglGetStringi), &flextglGetStringi>::bind("glGetStringi");
+    LazyEntry<decltype(flextglGetTexParameterIiv), &flextglGetTexParameterIiv>::bind("glGetTexParameterIiv");
+    LazyEntry<decltype(flextglGetTexParameterIuiv), &flextglGetTexParameterIuiv>::bind("glGetTexParameterIuiv");
+    LazyEntry<decltype(flextglGetTransformFeedbackVarying), &flextglGetTransformFeedbackVarying>::bind("glGetTransformFeedbackVarying");
+    LazyEntry<decltype(flextglGetUniformuiv), &flextglGetUniformuiv>::bind("glGetUniformuiv");
+    LazyEntry<decltype(flextglGetVertexAttribIiv), &flextglGetVertexAttribIiv>::bind("glGetVertexAttribIiv");
+    LazyEntry<decltype(flextglGetVertexAttribIuiv), &flextglGetVertexAttribIuiv>::bind("glGetVertexAttribIuiv");
+    LazyEntry<decltype(flextglIsEnabledi), &flextglIsEnabledi>::bind("glIsEnabledi");
+    LazyEntry<decltype(flextglIsFramebuffer), &flextglIsFramebuffer>::bind("glIsFramebuffer");
+    LazyEntry<decltype(flextglIsRenderbuffer), &flextglIsRenderbuffer>::bind("glIsRenderbuffer");
+    LazyEntry<decltype(flextglIsVertexArray), &flextglIsVertexArray>::bind("glIsVertexArray");
+    LazyEntry<decltype(flextglMapBufferRange), &flextglMapBufferRange>::bind("glMapBufferRange");
+    LazyEntry<decltype(flextglRenderbufferStorage), &flextglRenderbufferStorage>::bind("glRenderbufferStorage");
+    LazyEntry<decltype(flextglRenderbufferStorageMultisample), &flextglRenderbufferStorageMultisample>::bind("glRenderbufferStorageMultisample");
+    LazyEntry<decltype(flextglTexParameterIiv), &flextglTexParameterIiv>::bind("glTexParameterIiv");
+    LazyEntry<decltype(flextglTexParameterIuiv), &flextglTexParameterIuiv>::bind("glTexParameterIuiv");
+    LazyEntry<decltype(flextglTransformFeedbackVaryings), &flextglTransformFeedbackVaryings>::bind("glTransformFeedbackVaryings");
+    LazyEntry<decltype(flextglUniform1ui), &flextglUniform1ui>::bind("glUniform1ui");
+    LazyEntry<decltype(flextglUniform1uiv), &flextglUniform1uiv>::bind("glUniform1uiv");
+    LazyEntry<decltype(flextglUniform2ui), &flextglUniform2ui>::bind("glUniform2ui");
+    LazyEntry<decltype(flextglUniform2uiv), &flextglUniform2uiv>::bind("glUniform2uiv");
+    LazyEntry<decltype(flextglUniform3ui), &flextglUniform3ui>::bind("glUniform3ui");
+    LazyEntry<decltype(flextglUniform3uiv), &flextglUniform3uiv>::bind("glUniform3uiv");
+    LazyEntry<decltype(flextglUniform4ui), &flextglUniform4ui>::bind("glUniform4ui");
+    LazyEntry<decltype(flextglUniform4uiv), &flextglUniform4uiv>::bind("glUniform4uiv");
+    LazyEntry<decltype(flextglVertexAttribI1i), &flextglVertexAttribI1i>::bind("glVertexAttribI1i");
+    LazyEntry<decltype(flextglVertexAttribI1iv), &flextglVertexAttribI1iv>::bind("glVertexAttribI1iv");
+    LazyEntry<decltype(flextglVertexAttribI1ui), &flextglVertexAttribI1ui>::bind("glVertexAttribI1ui");
+    LazyEntry<decltype(flextglVertexAttribI1uiv), &flextglVertexAttribI1uiv>::bind("glVertexAttribI1uiv");
+    LazyEntry<decltype(flextglVertexAttribI2i), &flextglVertexAttribI2i>::bind("glVertexAttribI2i");
+    LazyEntry<decltype(flextglVertexAttribI2iv), &flextglVertexAttribI2iv>::bind("glVertexAttribI2iv");
+    LazyEntry<decltype(flextglVertexAttribI2ui), &flextglVertexAttribI2ui>::bind("glVertexAttribI2ui");
+    LazyEntry<decltype(flextglVertexAttribI2uiv), &flextglVertexAttribI2uiv>::bind("glVertexAttribI2uiv");
+    LazyEntry<decltype(flextglVertexAttribI3i), &flextglVertexAttribI3i>::bind("glVertexAttribI3i");
+    LazyEntry<decltype(flextglVertexAttribI3iv), &flextglVertexAttribI3iv>::bind("glVertexAttribI3iv");
+    LazyEntry<decltype(flextglVertexAttribI3ui), &flextglVertexAttribI3ui>::bind("glVertexAttribI3ui");
+    LazyEntry<decltype(flextglVertexAttribI3uiv), &flextglVertexAttribI3uiv>::bind("glVertexAttribI3uiv");
+    LazyEntry<decltype(flextglVertexAttribI4bv), &flextglVertexAttribI4bv>::bind("glVertexAttribI4bv");
+    LazyEntry<decltype(flextglVertexAttribI4i), &flextglVertexAttribI4i>::bind("glVertexAttribI4i");
+    LazyEntry<decltype(flextglVertexAttribI4iv), &flextglVertexAttribI4iv>::bind("glVertexAttribI4iv");
+    LazyEntry<decltype(flextglVertexAttribI4sv), &flextglVertexAttribI4sv>::bind("glVertexAttribI4sv");
+    LazyEntry<decltype(flextglVertexAttribI4ubv), &flextglVertexAttribI4ubv>::bind("glVertexAttribI4ubv");
+    LazyEntry<decltype(flextglVertexAttribI4ui), &flextglVertexAttribI4ui>::bind("glVertexAttribI4ui");
+    LazyEntry<decltype(flextglVertexAttribI4uiv), &flextglVertexAttribI4uiv>::bind("glVertexAttribI4uiv");
+    LazyEntry<decltype(flextglVertexAttribI4usv), &flextglVertexAttribI4usv>::bind("glVertexAttribI4usv");
+    LazyEntry<decltype(flextglVertexAttribIPointer), &flextglVertexAttribIPointer>::bind("glVertexAttribIPointer");
+
+    /* GL_VERSION_3_1 */
+    LazyEntry<decltype(flextglCopyBufferSubData), &flextglCopyBufferSubData>::bind("glCopyBufferSubData");
+    LazyEntry<decltype(flextglDrawArraysInstanced), &flextglDrawArraysInstanced>::bind("glDrawArraysInstanced");
+    LazyEntry<decltype(flextglDrawElementsInstanced), &flextglDrawElementsInstanced>::bind("glDrawElementsInstanced");
+    LazyEntry<decltype(flextglGetActiveUniformBlockName), &flextglGetActiveUniformBlockName>::bind("glGetActiveUniformBlockName");
+    LazyEntry<decltype(flextglGetActiveUniformBlockiv), &flextglGetActiveUniformBlockiv>::bind("glGetActiveUniformBlockiv");
+    LazyEntry<decltype(flextglGetActiveUniformName), &flextglGetActiveUniformName>::bind("glGetActiveUniformName");
+    LazyEntry<decltype(flextglGetActiveUniformsiv), &flextglGetActiveUniformsiv>::bind("glGetActiveUniformsiv");
+    LazyEntry<decltype(flextglGetUniformBlockIndex), &flextglGetUniformBlockIndex>::bind("glGetUniformBlockIndex");
+    LazyEntry<decltype(flextglGetUniformIndices), &flextglGetUniformIndices>::bind("glGetUniformIndices");
+    LazyEntry<decltype(flextglPrimitiveRestartIndex), &flextglPrimitiveRestartIndex>::bind("glPrimitiveRestartIndex");
+    LazyEntry<decltype(flextglTexBuffer), &flextglTexBuffer>::bind("glTexBuffer");
+    LazyEntry<decltype(flextglUniformBlockBinding), &flextglUniformBlockBinding>::bind("glUniformBlockBinding");
+
+    /* GL_VERSION_3_2 */
+    LazyEntry<decltype(flextglClientWaitSync), &flextglClientWaitSync>::bind("glClientWaitSync");
+    LazyEntry<decltype(flextglDeleteSync), &flextglDeleteSync>::bind("glDeleteSync");
+    LazyEntry<decltype(flextglDrawElementsBaseVertex), &flextglDrawElementsBaseVertex>::bind("glDrawElementsBaseVertex");
+    LazyEntry<decltype(flextglDrawElementsInstancedBaseVertex), &flextglDrawElementsInstancedBaseVertex>::bind("glDrawElementsInstancedBaseVertex");
+    LazyEntry<decltype(flextglDrawRangeElementsBaseVertex), &flextglDrawRangeElementsBaseVertex>::bind("glDrawRangeElementsBaseVertex");
+    LazyEntry<decltype(flextglFenceSync), &flextglFenceSync>::bind("glFenceSync");
+    LazyEntry<decltype(flextglFramebufferTexture), &flextglFramebufferTexture>::bind("glFramebufferTexture");
+    LazyEntry<decltype(flextglGetBufferParameteri64v), &flextglGetBufferParameteri64v>::bind("glGetBufferParameteri64v");
+    LazyEntry<decltype(flextglGetInteger64i_v), &flextglGetInteger64i_v>::bind("glGetInteger64i_v");
+    LazyEntry<decltype(flextglGetInteger64v), &flextglGetInteger64v>::bind("glGetInteger64v");
+    LazyEntry<decltype(flextglGetMultisamplefv), &flextglGetMultisamplefv>::bind("glGetMultisamplefv");
+    LazyEntry<decltype(flextglGetSynciv), &flextglGetSynciv>::bind("glGetSynciv");
+    LazyEntry<decltype(flextglIsSync), &flextglIsSync>::bind("glIsSync");
+    LazyEntry<decltype(flextglMultiDrawElementsBaseVertex), &flextglMultiDrawElementsBaseVertex>::bind("glMultiDrawElementsBaseVertex");
+    LazyEntry<decltype(flextglProvokingVertex), &flextglProvokingVertex>::bind("glProvokingVertex");
+    LazyEntry<decltype(flextglSampleMaski), &flextglSampleMaski>::bind("glSampleMaski");
+    LazyEntry<decltype(flextglTexImage2DMultisample), &flextglTexImage2DMultisample>::bind("glTexImage2DMultisample");
+    LazyEntry<decltype(flextglTexImage3DMultisample), &flextglTexImage3DMultisample>::bind("glTexImage3DMultisample");
+    LazyEntry<decltype(flextglWaitSync), &flextglWaitSync>::bind("glWaitSync");
+
+    /* GL_VERSION_3_3 */
+    LazyEntry<decltype(flextglBindFragDataLocationIndexed), &flextglBindFragDataLocationIndexed>::bind("glBindFragDataLocationIndexed");
+    LazyEntry<decltype(flextglBindSampler), &flextglBindSampler>::bind("glBindSampler");
+    LazyEntry<decltype(flextglDeleteSamplers), &flextglDeleteSamplers>::bind("glDeleteSamplers");
+    LazyEntry<decltype(flextglGenSamplers), &flextglGenSamplers>::bind("glGenSamplers");
+    LazyEntry<decltype(flextglGetFragDataIndex), &flextglGetFragDataIndex>::bind("glGetFragDataIndex");
+    LazyEntry<decltype(flextglGetQueryObjecti64v), &flextglGetQueryObjecti64v>::bind("glGetQueryObjecti64v");
+    LazyEntry<decltype(flextglGetQueryObjectui64v), &flextglGetQueryObjectui64v>::bind("glGetQueryObjectui64v");
+    LazyEntry<decltype(flextglGetSamplerParameterIiv), &flextglGetSamplerParameterIiv>::bind("glGetSamplerParameterIiv");
+    LazyEntry<decltype(flextglGetSamplerParameterIuiv), &flextglGetSamplerParameterIuiv>::bind("glGetSamplerParameterIuiv");
+    LazyEntry<decltype(flextglGetSamplerParameterfv), &flextglGetSamplerParameterfv>::bind("glGetSamplerParameterfv");
+    LazyEntry<decltype(flextglGetSamplerParameteriv), &flextglGetSamplerParameteriv>::bind("glGetSamplerParameteriv");
+    LazyEntry<decltype(flextglIsSampler), &flextglIsSampler>::bind("glIsSampler");
+    LazyEntry<decltype(flextglQueryCounter), &flextglQueryCounter>::bind("glQueryCounter");
+    LazyEntry<decltype(flextglSamplerParameterIiv), &flextglSamplerParameterIiv>::bind("glSamplerParameterIiv");
+    LazyEntry<decltype(flextglSamplerParameterIuiv), &flextglSamplerParameterIuiv>::bind("glSamplerParameterIuiv");
+    LazyEntry<decltype(flextglSamplerParameterf), &flextglSamplerParameterf>::bind("glSamplerParameterf");
+    LazyEntry<decltype(flextglSamplerParameterfv), &flextglSamplerParameterfv>::bind("glSamplerParameterfv");
+    LazyEntry<decltype(flextglSamplerParameteri), &flextglSamplerParameteri>::bind("glSamplerParameteri");
+    LazyEntry<decltype(flextglSamplerParameteriv), &flextglSamplerParameteriv>::bind("glSamplerParameteriv");
+    LazyEntry<decltype(flextglVertexAttribDivisor), &flextglVertexAttribDivisor>::bind("glVertexAttribDivisor");
+    LazyEntry<decltype(flextglVertexAttribP1ui), &flextglVertexAttribP1ui>::bind("glVertexAttribP1ui");
+    LazyEntry<decltype(flextglVertexAttribP1uiv), &flextglVertexAttribP1uiv>::bind("glVertexAttribP1uiv");
+    LazyEntry<decltype(flextglVertexAttribP2ui), &flextglVertexAttribP2ui>::bind("glVertexAttribP2ui");
+    LazyEntry<decltype(flextglVertexAttribP2uiv), &flextglVertexAttribP2uiv>::bind("glVertexAttribP2uiv");
+    LazyEntry<decltype(flextglVertexAttribP3ui), &flextglVertexAttribP3ui>::bind("glVertexAttribP3ui");
+    LazyEntry<decltype(flextglVertexAttribP3uiv), &flextglVertexAttribP3uiv>::bind("glVertexAttribP3uiv");
+    LazyEntry<decltype(flextglVertexAttribP4ui), &flextglVertexAttribP4ui>::bind("glVertexAttribP4ui");
+    LazyEntry<decltype(flextglVertexAttribP4uiv), &flextglVertexAttribP4uiv>::bind("glVertexAttribP4uiv");
+
+    /* GL_VERSION_4_0 */
+    LazyEntry<decltype(flextglBeginQueryIndexed), &flextglBeginQueryIndexed>::bind("glBeginQueryIndexed");
+    LazyEntry<decltype(flextglBindTransformFeedback), &flextglBindTransformFeedback>::bind("glBindTransformFeedback");
+    LazyEntry<decltype(flextglBlendEquationSeparatei), &flextglBlendEquationSeparatei>::bind("glBlendEquationSeparatei");
+    LazyEntry<decltype(flextglBlendEquationi), &flextglBlendEquationi>::bind("glBlendEquationi");
+    LazyEntry<decltype(flextglBlendFuncSeparatei), &flextglBlendFuncSeparatei>::bind("glBlendFuncSeparatei");
+    LazyEntry<decltype(flextglBlendFunci), &flextglBlendFunci>::bind("glBlendFunci");
+    LazyEntry<decltype(flextglDeleteTransformFeedbacks), &flextglDeleteTransformFeedbacks>::bind("glDeleteTransformFeedbacks");
+    LazyEntry<decltype(flextglDrawArraysIndirect), &flextglDrawArraysIndirect>::bind("glDrawArraysIndirect");
+    LazyEntry<decltype(flextglDrawElementsIndirect), &flextglDrawElementsIndirect>::bind("glDrawElementsIndirect");
+    LazyEntry<decltype(flextglDrawTransformFeedback), &flextglDrawTransformFeedback>::bind("glDrawTransformFeedback");
+    LazyEntry<decltype(flextglDrawTransformFeedbackStream), &flextglDrawTransformFeedbackStream>::bind("glDrawTransformFeedbackStream");
+    LazyEntry<decltype(flextglEndQueryIndexed), &flextglEndQueryIndexed>::bind("glEndQueryIndexed");
+    LazyEntry<decltype(flextglGenTransformFeedbacks), &flextglGenTransformFeedbacks>::bind("glGenTransformFeedbacks");
+    LazyEntry<decltype(flextglGetActiveSubroutineName), &flextglGetActiveSubroutineName>::bind("glGetActiveSubroutineName");
+    LazyEntry<decltype(flextglGetActiveSubroutineUniformName), &flextglGetActiveSubroutineUniformName>::bind("glGetActiveSubroutineUniformName");
+    LazyEntry<decltype(flextglGetActiveSubroutineUniformiv), &flextglGetActiveSubroutineUniformiv>::bind("glGetActiveSubroutineUniformiv");
+    LazyEntry<decltype(flextglGetProgramStageiv), &flextglGetProgramStageiv>::bind("glGetProgramStageiv");
+    LazyEntry<decltype(flextglGetQueryIndexediv), &flextglGetQueryIndexediv>::bind("glGetQueryIndexediv");
+    LazyEntry<decltype(flextglGetSubroutineIndex), &flextglGetSubroutineIndex>::bind("glGetSubroutineIndex");
+    LazyEntry<decltype(flextglGetSubroutineUniformLocation), &flextglGetSubroutineUniformLocation>::bind("glGetSubroutineUniformLocation");
+    LazyEntry<decltype(flextglGetUniformSubroutineuiv), &flextglGetUniformSubroutineuiv>::bind("glGetUniformSubroutineuiv");
+    LazyEntry<decltype(flextglGetUniformdv), &flextglGetUniformdv>::bind("glGetUniformdv");
+    LazyEntry<decltype(flextglIsTransformFeedback), &flextglIsTransformFeedback>::bind("glIsTransformFeedback");
+    LazyEntry<decltype(flextglMinSampleShading), &flextglMinSampleShading>::bind("glMinSampleShading");
+    LazyEntry<decltype(flextglPatchParameterfv), &flextglPatchParameterfv>::bind("glPatchParameterfv");
+    LazyEntry<decltype(flextglPatchParameteri), &flextglPatchParameteri>::bind("glPatchParameteri");
+    LazyEntry<decltype(flextglPauseTransformFeedback), &flextglPauseTransformFeedback>::bind("glPauseTransformFeedback");
+    LazyEntry<decltype(flextglResumeTransformFeedback), &flextglResumeTransformFeedback>::bind("glResumeTransformFeedback");
+    LazyEntry<decltype(flextglUniform1d), &flextglUniform1d>::bind("glUniform1d");
+    LazyEntry<decltype(flextglUniform1dv), &flextglUniform1dv>::bind("glUniform1dv");
+    LazyEntry<decltype(flextglUniform2d), &flextglUniform2d>::bind("glUniform2d");
+    LazyEntry<decltype(flextglUniform2dv), &flextglUniform2dv>::bind("glUniform2dv");
+    LazyEntry<decltype(flextglUniform3d), &flextglUniform3d>::bind("glUniform3d");
+    LazyEntry<decltype(flextglUniform3dv), &flextglUniform3dv>::bind("glUniform3dv");
+    LazyEntry<decltype(flextglUniform4d), &flextglUniform4d>::bind("glUniform4d");
+    LazyEntry<decltype(flextglUniform4dv), &flextglUniform4dv>::bind("glUniform4dv");
+    LazyEntry<decltype(flextglUniformMatrix2dv), &flextglUniformMatrix2dv>::bind("glUniformMatrix2dv");
+    LazyEntry<decltype(flextglUniformMatrix2x3dv), &flextglUniformMatrix2x3dv>::bind("glUniformMatrix2x3dv");
+    LazyEntry<decltype(flextglUniformMatrix2x4dv), &flextglUniformMatrix2x4dv>::bind("glUniformMatrix2x4dv");
+    LazyEntry<decltype(flextglUniformMatrix3dv), &flextglUniformMatrix3dv>::bind("glUniformMatrix3dv");
+    LazyEntry<decltype(flextglUniformMatrix3x2dv), &flextglUniformMatrix3x2dv>::bind("glUniformMatrix3x2dv");
+    LazyEntry<decltype(flextglUniformMatrix3x4dv), &flextglUniformMatrix3x4dv>::bind("glUniformMatrix3x4dv");
+    LazyEntry<decltype(flextglUniformMatrix4dv), &flextglUniformMatrix4dv>::bind("glUniformMatrix4dv");
+    LazyEntry<decltype(flextglUniformMatrix4x2dv), &flextglUniformMatrix4x2dv>::bind("glUniformMatrix4x2dv");
+    LazyEntry<decltype(flextglUniformMatrix4x3dv), &flextglUniformMatrix4x3dv>::bind("glUniformMatrix4x3dv");
+    LazyEntry<decltype(flextglUniformSubroutinesuiv), &flextglUniformSubroutinesuiv>::bind("glUniformSubroutinesuiv");
+
+    /* GL_VERSION_4_1 */
+    LazyEntry<decltype(flextglActiveShaderProgram), &flextglActiveShaderProgram>::bind("glActiveShaderProgram");
+    LazyEntry<decltype(flextglBindProgramPipeline), &flextglBindProgramPipeline>::bind("glBindProgramPipeline");
+    LazyEntry<decltype(flextglClearDepthf), &flextglClearDepthf>::bind("glClearDepthf");
+    LazyEntry<decltype(flextglCreateShaderProgramv), &flextglCreateShaderProgramv>::bind("glCreateShaderProgramv");
+    LazyEntry<decltype(flextglDeleteProgramPipelines), &flextglDeleteProgramPipelines>::bind("glDeleteProgramPipelines");
+    LazyEntry<decltype(flextglDepthRangeArrayv), &flextglDepthRangeArrayv>::bind("glDepthRangeArrayv");
+    LazyEntry<decltype(flextglDepthRangeIndexed), &flextglDepthRangeIndexed>::bind("glDepthRangeIndexed");
+    LazyEntry<decltype(flextglDepthRangef), &flextglDepthRangef>::bind("glDepthRangef");
+    LazyEntry<decltype(flextglGenProgramPipelines), &flextglGenProgramPipelines>::bind("glGenProgramPipelines");
+    LazyEntry<decltype(flextglGetDoublei_v), &flextglGetDoublei_v>::bind("glGetDoublei_v");
+    LazyEntry<decltype(flextglGetFloati_v), &flextglGetFloati_v>::bind("glGetFloati_v");
+    LazyEntry<decltype(flextglGetProgramBinary), &flextglGetProgramBinary>::bind("glGetProgramBinary");
+    LazyEntry<decltype(flextglGetProgramPipelineInfoLog), &flextglGetProgramPipelineInfoLog>::bind("glGetProgramPipelineInfoLog");
+    LazyEntry<decltype(flextglGetProgramPipelineiv), &flextglGetProgramPipelineiv>::bind("glGetProgramPipelineiv");
+    LazyEntry<decltype(flextglGetShaderPrecisionFormat), &flextglGetShaderPrecisionFormat>::bind("glGetShaderPrecisionFormat");
+    LazyEntry<decltype(flextglGetVertexAttribLdv), &flextglGetVertexAttribLdv>::bind("glGetVertexAttribLdv");
+    LazyEntry<decltype(flextglIsProgramPipeline), &flextglIsProgramPipeline>::bind("glIsProgramPipeline");
+    LazyEntry<decltype(flextglProgramBinary), &flextglProgramBinary>::bind("glProgramBinary");
+    LazyEntry<decltype(flextglProgramParameteri), &flextglProgramParameteri>::bind("glProgramParameteri");
+    LazyEntry<decltype(flextglProgramUniform1d), &flextglProgramUniform1d>::bind("glProgramUniform1d");
+    LazyEntry<decltype(flextglProgramUniform1dv), &flextglProgramUniform1dv>::bind("glProgramUniform1dv");
+    LazyEntry<decltype(flextglProgramUniform1f), &flextglProgramUniform1f>::bind("glProgramUniform1f");
+    LazyEntry<decltype(flextglProgramUniform1fv), &flextglProgramUniform1fv>::bind("glProgramUniform1fv");
+    LazyEntry<decltype(flextglProgramUniform1i), &flextglProgramUniform1i>::bind("glProgramUniform1i");
+    LazyEntry<decltype(flextglProgramUniform1iv), &flextglProgramUniform1iv>::bind("glProgramUniform1iv");
+    LazyEntry<decltype(flextglProgramUniform1ui), &flextglProgramUniform1ui>::bind("glProgramUniform1ui");
+    LazyEntry<decltype(flextglProgramUniform1uiv), &flextglProgramUniform1uiv>::bind("glProgramUniform1uiv");
+    LazyEntry<decltype(flextglProgramUniform2d), &flextglProgramUniform2d>::bind("glProgramUniform2d");
+    LazyEntry<decltype(flextglProgramUniform2dv), &flextglProgramUniform2dv>::bind("glProgramUniform2dv");
+    LazyEntry<decltype(flextglProgramUniform2f), &flextglProgramUniform2f>::bind("glProgramUniform2f");
+    LazyEntry<decltype(flextglProgramUniform2fv), &flextglProgramUniform2fv>::bind("glProgramUniform2fv");
+    LazyEntry<decltype(flextglProgramUniform2i), &flextglProgramUniform2i>::bind("glProgramUniform2i");
+    LazyEntry<decltype(flextglProgramUniform2iv), &flextglProgramUniform2iv>::bind("glProgramUniform2iv");
+    LazyEntry<decltype(flextglProgramUniform2ui), &flextglProgramUniform2ui>::bind("glProgramUniform2ui");
+    LazyEntry<decltype(flextglProgramUniform2uiv), &flextglProgramUniform2uiv>::bind("glProgramUniform2uiv");
+    LazyEntry<decltype(flextglProgramUniform3d), &flextglProgramUniform3d>::bind("glProgramUniform3d");
+    LazyEntry<decltype(flextglProgramUniform3dv), &flextglProgramUniform3dv>::bind("glProgramUniform3dv");
+    LazyEntry<decltype(flextglProgramUniform3f), &flextglProgramUniform3f>::bind("glProgramUniform3f");
+    LazyEntry<decltype(flextglProgramUniform3fv), &flextglProgramUniform3fv>::bind("glProgramUniform3fv");
+    LazyEntry<decltype(flextglProgramUniform3i), &flextglProgramUniform3i>::bind("glProgramUniform3i");
+    LazyEntry<decltype(flextglProgramUniform3iv), &flextglProgramUniform3iv>::bind("glProgramUniform3iv");
+    LazyEntry<decltype(flextglProgramUniform3ui), &flextglProgramUniform3ui>::bind("glProgramUniform3ui");
+    LazyEntry<decltype(flextglProgramUniform3uiv), &flextglProgramUniform3uiv>::bind("glProgramUniform3uiv");
+    LazyEntry<decltype(flextglProgramUniform4d), &flextglProgramUniform4d>::bind("glProgramUniform4d");
+    LazyEntry<decltype(flextglProgramUniform4dv), &flextglProgramUniform4dv>::bind("glProgramUniform4dv");
+    LazyEntry<decltype(flextglProgramUniform4f), &flextglProgramUniform4f>::bind("glProgramUniform4f");
+    LazyEntry<decltype(flextglProgramUniform4fv), &flextglProgramUniform4fv>::bind("glProgramUniform4fv");
+    LazyEntry<decltype(flextglProgramUniform4i), &flextglProgramUniform4i>::bind("glProgramUniform4i");
+    LazyEntry<decltype(flextglProgramUniform4iv), &flextglProgramUniform4iv>::bind("glProgramUniform4iv");
+    LazyEntry<decltype(flextglProgramUniform4ui), &flextglProgramUniform4ui>::bind("glProgramUniform4ui");
+    LazyEntry<decltype(flextglProgramUniform4uiv), &flextglProgramUniform4uiv>::bind("glProgramUniform4uiv");
+    LazyEntry<decltype(flextglProgramUniformMatrix2dv), &flextglProgramUniformMatrix2dv>::bind("glProgramUniformMatrix2dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix2fv), &flextglProgramUniformMatrix2fv>::bind("glProgramUniformMatrix2fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix2x3dv), &flextglProgramUniformMatrix2x3dv>::bind("glProgramUniformMatrix2x3dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix2x3fv), &flextglProgramUniformMatrix2x3fv>::bind("glProgramUniformMatrix2x3fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix2x4dv), &flextglProgramUniformMatrix2x4dv>::bind("glProgramUniformMatrix2x4dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix2x4fv), &flextglProgramUniformMatrix2x4fv>::bind("glProgramUniformMatrix2x4fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix3dv), &flextglProgramUniformMatrix3dv>::bind("glProgramUniformMatrix3dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix3fv), &flextglProgramUniformMatrix3fv>::bind("glProgramUniformMatrix3fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix3x2dv), &flextglProgramUniformMatrix3x2dv>::bind("glProgramUniformMatrix3x2dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix3x2fv), &flextglProgramUniformMatrix3x2fv>::bind("glProgramUniformMatrix3x2fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix3x4dv), &flextglProgramUniformMatrix3x4dv>::bind("glProgramUniformMatrix3x4dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix3x4fv), &flextglProgramUniformMatrix3x4fv>::bind("glProgramUniformMatrix3x4fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix4dv), &flextglProgramUniformMatrix4dv>::bind("glProgramUniformMatrix4dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix4fv), &flextglProgramUniformMatrix4fv>::bind("glProgramUniformMatrix4fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix4x2dv), &flextglProgramUniformMatrix4x2dv>::bind("glProgramUniformMatrix4x2dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix4x2fv), &flextglProgramUniformMatrix4x2fv>::bind("glProgramUniformMatrix4x2fv");
+    LazyEntry<decltype(flextglProgramUniformMatrix4x3dv), &flextglProgramUniformMatrix4x3dv>::bind("glProgramUniformMatrix4x3dv");
+    LazyEntry<decltype(flextglProgramUniformMatrix4x3fv), &flextglProgramUniformMatrix4x3fv>::bind("glProgramUniformMatrix4x3fv");
+    LazyEntry<decltype(flextglReleaseShaderCompiler), &flextglReleaseShaderCompiler>::bind("glReleaseShaderCompiler");
+    LazyEntry<decltype(flextglScissorArrayv), &flextglScissorArrayv>::bind("glScissorArrayv");
+    LazyEntry<decltype(flextglScissorIndexed), &flextglScissorIndexed>::bind("glScissorIndexed");
+    LazyEntry<decltype(flextglScissorIndexedv), &flextglScissorIndexedv>::bind("glScissorIndexedv");
+    LazyEntry<decltype(flextglShaderBinary), &flextglShaderBinary>::bind("glShaderBinary");
+    LazyEntry<decltype(flextglUseProgramStages), &flextglUseProgramStages>::bind("glUseProgramStages");
+    LazyEntry<decltype(flextglValidateProgramPipeline), &flextglValidateProgramPipeline>::bind("glValidateProgramPipeline");
+    LazyEntry<decltype(flextglVertexAttribL1d), &flextglVertexAttribL1d>::bind("glVertexAttribL1d");
+    LazyEntry<decltype(flextglVertexAttribL1dv), &flextglVertexAttribL1dv>::bind("glVertexAttribL1dv");
+    LazyEntry<decltype(flextglVertexAttribL2d), &flextglVertexAttribL2d>::bind("glVertexAttribL2d");
+    LazyEntry<decltype(flextglVertexAttribL2dv), &flextglVertexAttribL2dv>::bind("glVertexAttribL2dv");
+    LazyEntry<decltype(flextglVertexAttribL3d), &flextglVertexAttribL3d>::bind("glVertexAttribL3d");
+    LazyEntry<decltype(flextglVertexAttribL3dv), &flextglVertexAttribL3dv>::bind("glVertexAttribL3dv");
+    LazyEntry<decltype(flextglVertexAttribL4d), &flextglVertexAttribL4d>::bind("glVertexAttribL4d");
+    LazyEntry<decltype(flextglVertexAttribL4dv), &flextglVertexAttribL4dv>::bind("glVertexAttribL4dv");
+    LazyEntry<decltype(flextglVertexAttribLPointer), &flextglVertexAttribLPointer>::bind("glVertexAttribLPointer");
+    LazyEntry<decltype(flextglViewportArrayv), &flextglViewportArrayv>::bind("glViewportArrayv");
+    LazyEntry<decltype(flextglViewportIndexedf), &flextglViewportIndexedf>::bind("glViewportIndexedf");
+    LazyEntry<decltype(flextglViewportIndexedfv), &flextglViewportIndexedfv>::bind("glViewportIndexedfv");
+
+    /* GL_VERSION_4_2 */
+    LazyEntry<decltype(flextglBindImageTexture), &flextglBindImageTexture>::bind("glBindImageTexture");
+    LazyEntry<decltype(flextglDrawArraysInstancedBaseInstance), &flextglDrawArraysInstancedBaseInstance>::bind("glDrawArraysInstancedBaseInstance");
+    LazyEntry<decltype(flextglDrawElementsInstancedBaseInstance), &flextglDrawElementsInstancedBaseInstance>::bind("glDrawElementsInstancedBaseInstance");
+    LazyEntry<decltype(flextglDrawElementsInstancedBaseVertexBaseInstance), &flextglDrawElementsInstancedBaseVertexBaseInstance>::bind("glDrawElementsInstancedBaseVertexBaseInstance");
+    LazyEntry<decltype(flextglDrawTransformFeedbackInstanced), &flextglDrawTransformFeedbackInstanced>::bind("glDrawTransformFeedbackInstanced");
+    LazyEntry<decltype(flextglDrawTransformFeedbackStreamInstanced), &flextglDrawTransformFeedbackStreamInstanced>::bind("glDrawTransformFeedbackStreamInstanced");
+    LazyEntry<decltype(flextglGetActiveAtomicCounterBufferiv), &flextglGetActiveAtomicCounterBufferiv>::bind("glGetActiveAtomicCounterBufferiv");
+    LazyEntry<decltype(flextglGetInternalformativ), &flextglGetInternalformativ>::bind("glGetInternalformativ");
+    LazyEntry<decltype(flextglMemoryBarrier), &flextglMemoryBarrier>::bind("glMemoryBarrier");
+    LazyEntry<decltype(flextglTexStorage1D), &flextglTexStorage1D>::bind("glTexStorage1D");
+    LazyEntry<decltype(flextglTexStorage2D), &flextglTexStorage2D>::bind("glTexStorage2D");
+    LazyEntry<decltype(flextglTexStorage3D), &flextglTexStorage3D>::bind("glTexStorage3D");
+
+    /* GL_VERSION_4_3 */
+    LazyEntry<decltype(flextglBindVertexBuffer), &flextglBindVertexBuffer>::bind("glBindVertexBuffer");
+    LazyEntry<decltype(flextglClearBufferData), &flextglClearBufferData>::bind("glClearBufferData");
+    LazyEntry<decltype(flextglClearBufferSubData), &flextglClearBufferSubData>::bind("glClearBufferSubData");
+    LazyEntry<decltype(flextglCopyImageSubData), &flextglCopyImageSubData>::bind("glCopyImageSubData");
+    LazyEntry<decltype(flextglDebugMessageCallback), &flextglDebugMessageCallback>::bind("glDebugMessageCallback");
+    LazyEntry<decltype(flextglDebugMessageControl), &flextglDebugMessageControl>::bind("glDebugMessageControl");
+    LazyEntry<decltype(flextglDebugMessageInsert), &flextglDebugMessageInsert>::bind("glDebugMessageInsert");
+    LazyEntry<decltype(flextglDispatchCompute), &flextglDispatchCompute>::bind("glDispatchCompute");
+    LazyEntry<decltype(flextglDispatchComputeIndirect), &flextglDispatchComputeIndirect>::bind("glDispatchComputeIndirect");
+    LazyEntry<decltype(flextglFramebufferParameteri), &flextglFramebufferParameteri>::bind("glFramebufferParameteri");
+    LazyEntry<decltype(flextglGetDebugMessageLog), &flextglGetDebugMessageLog>::bind("glGetDebugMessageLog");
+    LazyEntry<decltype(flextglGetFramebufferParameteriv), &flextglGetFramebufferParameteriv>::bind("glGetFramebufferParameteriv");
+    LazyEntry<decltype(flextglGetInternalformati64v), &flextglGetInternalformati64v>::bind("glGetInternalformati64v");
+    LazyEntry<decltype(flextglGetObjectLabel), &flextglGetObjectLabel>::bind("glGetObjectLabel");
+    LazyEntry<decltype(flextglGetObjectPtrLabel), &flextglGetObjectPtrLabel>::bind("glGetObjectPtrLabel");
+    LazyEntry<decltype(flextglGetPointerv), &flextglGetPointerv>::bind("glGetPointerv");
+    LazyEntry<decltype(flextglGetProgramInterfaceiv), &flextglGetProgramInterfaceiv>::bind("glGetProgramInterfaceiv");
+    LazyEntry<decltype(flextglGetProgramResourceIndex), &flextglGetProgramResourceIndex>::bind("glGetProgramResourceIndex");
+    LazyEntry<decltype(flextglGetProgramResourceLocation), &flextglGetProgramResourceLocation>::bind("glGetProgramResourceLocation");
+    LazyEntry<decltype(flextglGetProgramResourceLocationIndex), &flextglGetProgramResourceLocationIndex>::bind("glGetProgramResourceLocationIndex");
+    LazyEntry<decltype(flextglGetProgramResourceName), &flextglGetProgramResourceName>::bind("glGetProgramResourceName");
+    LazyEntry<decltype(flextglGetProgramResourceiv), &flextglGetProgramResourceiv>::bind("glGetProgramResourceiv");
+    LazyEntry<decltype(flextglInvalidateBufferData), &flextglInvalidateBufferData>::bind("glInvalidateBufferData");
+    LazyEntry<decltype(flextglInvalidateBufferSubData), &flextglInvalidateBufferSubData>::bind("glInvalidateBufferSubData");
+    LazyEntry<decltype(flextglInvalidateFramebuffer), &flextglInvalidateFramebuffer>::bind("glInvalidateFramebuffer");
+    LazyEntry<decltype(flextglInvalidateSubFramebuffer), &flextglInvalidateSubFramebuffer>::bind("glInvalidateSubFramebuffer");
+    LazyEntry<decltype(flextglInvalidateTexImage), &flextglInvalidateTexImage>::bind("glInvalidateTexImage");
+    LazyEntry<decltype(flextglInvalidateTexSubImage), &flextglInvalidateTexSubImage>::bind("glInvalidateTexSubImage");
+    LazyEntry<decltype(flextglMultiDrawArraysIndirect), &flextglMultiDrawArraysIndirect>::bind("glMultiDrawArraysIndirect");
+    LazyEntry<decltype(flextglMultiDrawElementsIndirect), &flextglMultiDrawElementsIndirect>::bind("glMultiDrawElementsIndirect");
+    LazyEntry<decltype(flextglObjectLabel), &flextglObjectLabel>::bind("glObjectLabel");
+    LazyEntry<decltype(flextglObjectPtrLabel), &flextglObjectPtrLabel>::bind("glObjectPtrLabel");
+    LazyEntry<decltype(flextglPopDebugGroup), &flextglPopDebugGroup>::bind("glPopDebugGroup");
+    LazyEntry<decltype(flextglPushDebugGroup), &flextglPushDebugGroup>::bind("glPushDebugGroup");
+    LazyEntry<decltype(flextglShaderStorageBlockBinding), &flextglShaderStorageBlockBinding>::bind("glShaderStorageBlockBinding");
+    LazyEntry<decltype(flextglTexBufferRange), &flextglTexBufferRange>::bind("glTexBufferRange");
+    LazyEntry<decltype(flextglTexStorage2DMultisample), &flextglTexStorage2DMultisample>::bind("glTexStorage2DMultisample");
+    LazyEntry<decltype(flextglTexStorage3DMultisample), &flextglTexStorage3DMultisample>::bind("glTexStorage3DMultisample");
+    LazyEntry<decltype(flextglTextureView), &flextglTextureView>::bind("glTextureView");
+    LazyEntry<decltype(flextglVertexAttribBinding), &flextglVertexAttribBinding>::bind("glVertexAttribBinding");
+    LazyEntry<decltype(flextglVertexAttribFormat), &flextglVertexAttribFormat>::bind("glVertexAttribFormat");
+    LazyEntry<decltype(flextglVertexAttribIFormat), &flextglVertexAttribIFormat>::bind("glVertexAttribIFormat");
+    LazyEntry<decltype(flextglVertexAttribLFormat), &flextglVertexAttribLFormat>::bind("glVertexAttribLFormat");
+    LazyEntry<decltype(flextglVertexBindingDivisor), &flextglVertexBindingDivisor>::bind("glVertexBindingDivisor");
+
+    /* GL_VERSION_4_4 */
+    LazyEntry<decltype(flextglBindBuffersBase), &flextglBindBuffersBase>::bind("glBindBuffersBase");
+    LazyEntry<decltype(flextglBindBuffersRange), &flextglBindBuffersRange>::bind("glBindBuffersRange");
+    LazyEntry<decltype(flextglBindImageTextures), &flextglBindImageTextures>::bind("glBindImageTextures");
+    LazyEntry<decltype(flextglBindSamplers), &flextglBindSamplers>::bind("glBindSamplers");
+    LazyEntry<decltype(flextglBindTextures), &flextglBindTextures>::bind("glBindTextures");
+    LazyEntry<decltype(flextglBindVertexBuffers), &flextglBindVertexBuffers>::bind("glBindVertexBuffers");
+    LazyEntry<decltype(flextglBufferStorage), &flextglBufferStorage>::bind("glBufferStorage");
+    LazyEntry<decltype(flextglClearTexImage), &flextglClearTexImage>::bind("glClearTexImage");
+    LazyEntry<decltype(flextglClearTexSubImage), &flextglClearTexSubImage>::bind("glClearTexSubImage");
+
+    /* GL_VERSION_4_5 */
+    LazyEntry<decltype(flextglBindTextureUnit), &flextglBindTextureUnit>::bind("glBindTextureUnit");
+    LazyEntry<decltype(flextglBlitNamedFramebuffer), &flextglBlitNamedFramebuffer>::bind("glBlitNamedFramebuffer");
+    LazyEntry<decltype(flextglCheckNamedFramebufferStatus), &flextglCheckNamedFramebufferStatus>::bind("glCheckNamedFramebufferStatus");
+    LazyEntry<decltype(flextglClearNamedBufferData), &flextglClearNamedBufferData>::bind("glClearNamedBufferData");
+    LazyEntry<decltype(flextglClearNamedBufferSubData), &flextglClearNamedBufferSubData>::bind("glClearNamedBufferSubData");
+    LazyEntry<decltype(flextglClearNamedFramebufferfi), &flextglClearNamedFramebufferfi>::bind("glClearNamedFramebufferfi");
+    LazyEntry<decltype(flextglClearNamedFramebufferfv), &flextglClearNamedFramebufferfv>::bind("glClearNamedFramebufferfv");
+    LazyEntry<decltype(flextglClearNamedFramebufferiv), &flextglClearNamedFramebufferiv>::bind("glClearNamedFramebufferiv");
+    LazyEntry<decltype(flextglClearNamedFramebufferuiv), &flextglClearNamedFramebufferuiv>::bind("glClearNamedFramebufferuiv");
+    LazyEntry<decltype(flextglClipControl), &flextglClipControl>::bind("glClipControl");
+    LazyEntry<decltype(flextglCompressedTextureSubImage1D), &flextglCompressedTextureSubImage1D>::bind("glCompressedTextureSubImage1D");
+    LazyEntry<decltype(flextglCompressedTextureSubImage2D), &flextglCompressedTextureSubImage2D>::bind("glCompressedTextureSubImage2D");
+    LazyEntry<decltype(flextglCompressedTextureSubImage3D), &flextglCompressedTextureSubImage3D>::bind("glCompressedTextureSubImage3D");
+    LazyEntry<decltype(flextglCopyNamedBufferSubData), &flextglCopyNamedBufferSubData>::bind("glCopyNamedBufferSubData");
+    LazyEntry<decltype(flextglCopyTextureSubImage1D), &flextglCopyTextureSubImage1D>::bind("glCopyTextureSubImage1D");
+    LazyEntry<decltype(flextglCopyTextureSubImage2D), &flextglCopyTextureSubImage2D>::bind("glCopyTextureSubImage2D");
+    LazyEntry<decltype(flextglCopyTextureSubImage3D), &flextglCopyTextureSubImage3D>::bind("glCopyTextureSubImage3D");
+    LazyEntry<decltype(flextglCreateBuffers), &flextglCreateBuffers>::bind("glCreateBuffers");
+    LazyEntry<decltype(flextglCreateFramebuffers), &flextglCreateFramebuffers>::bind("glCreateFramebuffers");
+    LazyEntry<decltype(flextglCreateProgramPipelines), &flextglCreateProgramPipelines>::bind("glCreateProgramPipelines");
+    LazyEntry<decltype(flextglCreateQueries), &flextglCreateQueries>::bind("glCreateQueries");
+    LazyEntry<decltype(flextglCreateRenderbuffers), &flextglCreateRenderbuffers>::bind("glCreateRenderbuffers");
+    LazyEntry<decltype(flextglCreateSamplers), &flextglCreateSamplers>::bind("glCreateSamplers");
+    LazyEntry<decltype(flextglCreateTextures), &flextglCreateTextures>::bind("glCreateTextures");
+    LazyEntry<decltype(flextglCreateTransformFeedbacks), &flextglCreateTransformFeedbacks>::bind("glCreateTransformFeedbacks");
+    LazyEntry<decltype(flextglCreateVertexArrays), &flextglCreateVertexArrays>::bind("glCreateVertexArrays");
+    LazyEntry<decltype(flextglDisableVertexArrayAttrib), &flextglDisableVertexArrayAttrib>::bind("glDisableVertexArrayAttrib");
+    LazyEntry<decltype(flextglEnableVertexArrayAttrib), &flextglEnableVertexArrayAttrib>::bind("glEnableVertexArrayAttrib");
+    LazyEntry<decltype(flextglFlushMappedNamedBufferRange), &flextglFlushMappedNamedBufferRange>::bind("glFlushMappedNamedBufferRange");
+    LazyEntry<decltype(flextglGenerateTextureMipmap), &flextglGenerateTextureMipmap>::bind("glGenerateTextureMipmap");
+    LazyEntry<decltype(flextglGetCompressedTextureImage), &flextglGetCompressedTextureImage>::bind("glGetCompressedTextureImage");
+    LazyEntry<decltype(flextglGetCompressedTextureSubImage), &flextglGetCompressedTextureSubImage>::bind("glGetCompressedTextureSubImage");
+    LazyEntry<decltype(flextglGetGraphicsResetStatus), &flextglGetGraphicsResetStatus>::bind("glGetGraphicsResetStatus");
+    LazyEntry<decltype(flextglGetNamedBufferParameteri64v), &flextglGetNamedBufferParameteri64v>::bind("glGetNamedBufferParameteri64v");
+    LazyEntry<decltype(flextglGetNamedBufferParameteriv), &flextglGetNamedBufferParameteriv>::bind("glGetNamedBufferParameteriv");
+    LazyEntry<decltype(flextglGetNamedBufferPointerv), &flextglGetNamedBufferPointerv>::bind("glGetNamedBufferPointerv");
+    LazyEntry<decltype(flextglGetNamedBufferSubData), &flextglGetNamedBufferSubData>::bind("glGetNamedBufferSubData");
+    LazyEntry<decltype(flextglGetNamedFramebufferAttachmentParameteriv), &flextglGetNamedFramebufferAttachmentParameteriv>::bind("glGetNamedFramebufferAttachmentParameteriv");
+    LazyEntry<decltype(flextglGetNamedFramebufferParameteriv), &flextglGetNamedFramebufferParameteriv>::bind("glGetNamedFramebufferParameteriv");
+    LazyEntry<decltype(flextglGetNamedRenderbufferParameteriv), &flextglGetNamedRenderbufferParameteriv>::bind("glGetNamedRenderbufferParameteriv");
+    LazyEntry<decltype(flextglGetQueryBufferObjecti64v), &flextglGetQueryBufferObjecti64v>::bind("glGetQueryBufferObjecti64v");
+    LazyEntry<decltype(flextglGetQueryBufferObjectiv), &flextglGetQueryBufferObjectiv>::bind("glGetQueryBufferObjectiv");
+    LazyEntry<decltype(flextglGetQueryBufferObjectui64v), &flextglGetQueryBufferObjectui64v>::bind("glGetQueryBufferObjectui64v");
+    LazyEntry<decltype(flextglGetQueryBufferObjectuiv), &flextglGetQueryBufferObjectuiv>::bind("glGetQueryBufferObjectuiv");
+    LazyEntry<decltype(flextglGetTextureImage), &flextglGetTextureImage>::bind("glGetTextureImage");
+    LazyEntry<decltype(flextglGetTextureLevelParameterfv), &flextglGetTextureLevelParameterfv>::bind("glGetTextureLevelParameterfv");
+    LazyEntry<decltype(flextglGetTextureLevelParameteriv), &flextglGetTextureLevelParameteriv>::bind("glGetTextureLevelParameteriv");
+    LazyEntry<decltype(flextglGetTextureParameterIiv), &flextglGetTextureParameterIiv>::bind("glGetTextureParameterIiv");
+    LazyEntry<decltype(flextglGetTextureParameterIuiv), &flextglGetTextureParameterIuiv>::bind("glGetTextureParameterIuiv");
+    LazyEntry<decltype(flextglGetTextureParameterfv), &flextglGetTextureParameterfv>::bind("glGetTextureParameterfv");
+    LazyEntry<decltype(flextglGetTextureParameteriv), &flextglGetTextureParameteriv>::bind("glGetTextureParameteriv");
+    LazyEntry<decltype(flextglGetTextureSubImage), &flextglGetTextureSubImage>::bind("glGetTextureSubImage");
+    LazyEntry<decltype(flextglGetTransformFeedbacki64_v), &flextglGetTransformFeedbacki64_v>::bind("glGetTransformFeedbacki64_v");
+    LazyEntry<decltype(flextglGetTransformFeedbacki_v), &flextglGetTransformFeedbacki_v>::bind("glGetTransformFeedbacki_v");
+    LazyEntry<decltype(flextglGetTransformFeedbackiv), &flextglGetTransformFeedbackiv>::bind("glGetTransformFeedbackiv");
+    LazyEntry<decltype(flextglGetVertexArrayIndexed64iv), &flextglGetVertexArrayIndexed64iv>::bind("glGetVertexArrayIndexed64iv");
+    LazyEntry<decltype(flextglGetVertexArrayIndexediv), &flextglGetVertexArrayIndexediv>::bind("glGetVertexArrayIndexediv");
+    LazyEntry<decltype(flextglGetVertexArrayiv), &flextglGetVertexArrayiv>::bind("glGetVertexArrayiv");
+    LazyEntry<decltype(flextglGetnCompressedTexImage), &flextglGetnCompressedTexImage>::bind("glGetnCompressedTexImage");
+    LazyEntry<decltype(flextglGetnTexImage), &flextglGetnTexImage>::bind("glGetnTexImage");
+    LazyEntry<decltype(flextglGetnUniformdv), &flextglGetnUniformdv>::bind("glGetnUniformdv");
+    LazyEntry<decltype(flextglGetnUniformfv), &flextglGetnUniformfv>::bind("glGetnUniformfv");
+    LazyEntry<decltype(flextglGetnUniformiv), &flextglGetnUniformiv>::bind("glGetnUniformiv");
+    LazyEntry<decltype(flextglGetnUniformuiv), &flextglGetnUniformuiv>::bind("glGetnUniformuiv");
+    LazyEntry<decltype(flextglInvalidateNamedFramebufferData), &flextglInvalidateNamedFramebufferData>::bind("glInvalidateNamedFramebufferData");
+    LazyEntry<decltype(flextglInvalidateNamedFramebufferSubData), &flextglInvalidateNamedFramebufferSubData>::bind("glInvalidateNamedFramebufferSubData");
+    LazyEntry<decltype(flextglMapNamedBuffer), &flextglMapNamedBuffer>::bind("glMapNamedBuffer");
+    LazyEntry<decltype(flextglMapNamedBufferRange), &flextglMapNamedBufferRange>::bind("glMapNamedBufferRange");
+    LazyEntry<decltype(flextglMemoryBarrierByRegion), &flextglMemoryBarrierByRegion>::bind("glMemoryBarrierByRegion");
+    LazyEntry<decltype(flextglNamedBufferData), &flextglNamedBufferData>::bind("glNamedBufferData");
+    LazyEntry<decltype(flextglNamedBufferStorage), &flextglNamedBufferStorage>::bind("glNamedBufferStorage");
+    LazyEntry<decltype(flextglNamedBufferSubData), &flextglNamedBufferSubData>::bind("glNamedBufferSubData");
+    LazyEntry<decltype(flextglNamedFramebufferDrawBuffer), &flextglNamedFramebufferDrawBuffer>::bind("glNamedFramebufferDrawBuffer");
+    LazyEntry<decltype(flextglNamedFramebufferDrawBuffers), &flextglNamedFramebufferDrawBuffers>::bind("glNamedFramebufferDrawBuffers");
+    LazyEntry<decltype(flextglNamedFramebufferParameteri), &flextglNamedFramebufferParameteri>::bind("glNamedFramebufferParameteri");
+    LazyEntry<decltype(flextglNamedFramebufferReadBuffer), &flextglNamedFramebufferReadBuffer>::bind("glNamedFramebufferReadBuffer");
+    LazyEntry<decltype(flextglNamedFramebufferRenderbuffer), &flextglNamedFramebufferRenderbuffer>::bind("glNamedFramebufferRenderbuffer");
+    LazyEntry<decltype(flextglNamedFramebufferTexture), &flextglNamedFramebufferTexture>::bind("glNamedFramebufferTexture");
+    LazyEntry<decltype(flextglNamedFramebufferTextureLayer), &flextglNamedFramebufferTextureLayer>::bind("glNamedFramebufferTextureLayer");
+    LazyEntry<decltype(flextglNamedRenderbufferStorage), &flextglNamedRenderbufferStorage>::bind("glNamedRenderbufferStorage");
+    LazyEntry<decltype(flextglNamedRenderbufferStorageMultisample), &flextglNamedRenderbufferStorageMultisample>::bind("glNamedRenderbufferStorageMultisample");
+    LazyEntry<decltype(flextglReadnPixels), &flextglReadnPixels>::bind("glReadnPixels");
+    LazyEntry<decltype(flextglTextureBarrier), &flextglTextureBarrier>::bind("glTextureBarrier");
+    LazyEntry<decltype(flextglTextureBuffer), &flextglTextureBuffer>::bind("glTextureBuffer");
+    LazyEntry<decltype(flextglTextureBufferRange), &flextglTextureBufferRange>::bind("glTextureBufferRange");
+    LazyEntry<decltype(flextglTextureParameterIiv), &flextglTextureParameterIiv>::bind("glTextureParameterIiv");
+    LazyEntry<decltype(flextglTextureParameterIuiv), &flextglTextureParameterIuiv>::bind("glTextureParameterIuiv");
+    LazyEntry<decltype(flextglTextureParameterf), &flextglTextureParameterf>::bind("glTextureParameterf");
+    LazyEntry<decltype(flextglTextureParameterfv), &flextglTextureParameterfv>::bind("glTextureParameterfv");
+    LazyEntry<decltype(flextglTextureParameteri), &flextglTextureParameteri>::bind("glTextureParameteri");
+    LazyEntry<decltype(flextglTextureParameteriv), &flextglTextureParameteriv>::bind("glTextureParameteriv");
+    LazyEntry<decltype(flextglTextureStorage1D), &flextglTextureStorage1D>::bind("glTextureStorage1D");
+    LazyEntry<decltype(flextglTextureStorage2D), &flextglTextureStorage2D>::bind("glTextureStorage2D");
+    LazyEntry<decltype(flextglTextureStorage2DMultisample), &flextglTextureStorage2DMultisample>::bind("glTextureStorage2DMultisample");
+    LazyEntry<decltype(flextglTextureStorage3D), &flextglTextureStorage3D>::bind("glTextureStorage3D");
+    LazyEntry<decltype(flextglTextureStorage3DMultisample), &flextglTextureStorage3DMultisample>::bind("glTextureStorage3DMultisample");
+    LazyEntry<decltype(flextglTextureSubImage1D), &flextglTextureSubImage1D>::bind("glTextureSubImage1D");
+    LazyEntry<decltype(flextglTextureSubImage2D), &flextglTextureSubImage2D>::bind("glTextureSubImage2D");
+    LazyEntry<decltype(flextglTextureSubImage3D), &flextglTextureSubImage3D>::bind("glTextureSubImage3D");
+    LazyEntry<decltype(flextglTransformFeedbackBufferBase), &flextglTransformFeedbackBufferBase>::bind("glTransformFeedbackBufferBase");
+    LazyEntry<decltype(flextglTransformFeedbackBufferRange), &flextglTransformFeedbackBufferRange>::bind("glTransformFeedbackBufferRange");
+    LazyEntry<decltype(flextglUnmapNamedBuffer), &flextglUnmapNamedBuffer>::bind("glUnmapNamedBuffer");
+    LazyEntry<decltype(flextglVertexArrayAttribBinding), &flextglVertexArrayAttribBinding>::bind("glVertexArrayAttribBinding");
+    LazyEntry<decltype(flextglVertexArrayAttribFormat), &flextglVertexArrayAttribFormat>::bind("glVertexArrayAttribFormat");
+    LazyEntry<decltype(flextglVertexArrayAttribIFormat), &flextglVertexArrayAttribIFormat>::bind("glVertexArrayAttribIFormat");
+    LazyEntry<decltype(flextglVertexArrayAttribLFormat), &flextglVertexArrayAttribLFormat>::bind("glVertexArrayAttribLFormat");
+    LazyEntry<decltype(flextglVertexArrayBindingDivisor), &flextglVertexArrayBindingDivisor>::bind("glVertexArrayBindingDivisor");
+    LazyEntry<decltype(flextglVertexArrayElementBuffer), &flextglVertexArrayElementBuffer>::bind("glVertexArrayElementBuffer");
+    LazyEntry<decltype(flextglVertexArrayVertexBuffer), &flextglVertexArrayVertexBuffer>::bind("glVertexArrayVertexBuffer");
+    LazyEntry<decltype(flextglVertexArrayVertexBuffers), &flextglVertexArrayVertexBuffers>::bind("glVertexArrayVertexBuffers");
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+"""Writes profile.txt for flextGL with only the GL functions called by the application sources.
+
+Regenerating flextGL.h/flextGL.cpp/flextGLInit.cpp from this profile drops every other entry point:
+    python3 gen_profile.py && flextGLgen.py -T . -D . profile.txt
+--check only reports whether profile.txt is up to date (exit code 1 if not).
+"""
+import os
+import re
+import sys
+
+GL_DIR = os.path.dirname(os.path.abspath(__file__))
+SOURCE_DIR = os.path.dirname(GL_DIR)
+PROFILE = os.path.join(GL_DIR, 'profile.txt')
+VERSION = 'version 4.5 core'
+CALL = re.compile(r'\bgl([A-Z][A-Za-z0-9]*)\s*\(')
+
+
+def used_functions():
+    names = set()
+    for root, dirs, files in os.walk(SOURCE_DIR):
+        dirs[:] = [d for d in dirs if os.path.join(root, d) != GL_DIR]
+        for f in files:
+            if f.endswith(('.cpp', '.h', '.inl')):
+                with open(os.path.join(root, f), encoding='utf-8', errors='replace') as src:
+                    names.update(CALL.findall(src.read()))
+    return sorted(names)
+
+
+def main():
+    profile = '\n'.join([VERSION, '', 'begin functions'] + used_functions() + ['end functions', ''])
+    if '--check' in sys.argv[1:]:
+        with open(PROFILE) as f:
+            current = f.read()
+        if current != profile:
+            print('profile.txt is out of date, run gen_profile.py')
+            return 1
+        return 0
+    with open(PROFILE, 'w', newline='\n') as f:
+        f.write(profile)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -4,167 +4,655 @@
 #include "maths/Mat4.h"
 #include "tga/tga.h"
 #include "utility/Clock.h"
+#include "utility/FileWatcher.h"
+#include "utility/FixedTimestep.h"
+#include "utility/ThreadPool.h"
+#include "utility/Trace.h"
 #include "CameraController.h"
+#include "CpuBarnesHut.h"
+#include "CpuParticleMesh.h"
+#include "CpuParticleSimulator.h"
+#include "ForceField.h"
+#include "FrustumCuller.h"
+#include "GlParticleCompactor.h"
+#include "GpuProfiler.h"
+#include "GlParticleSimulator.h"
+#include "GlBarnesHut.h"
+#include "GlParticleMesh.h"
+#include "GlSpatialHash.h"
+#include "GlStateReadback.h"
+#include "HeadlessContext.h"
+#include "Options.h"
+#include "ParticleSpawner.h"
+#include "ParticleStorage.h"
+#include "ParticleSystemManager.h"
+#include "ProgramCache.h"
+#include "ProgramGroups.h"
+#include "Recording.h"
+#include "ReplayParticleSimulator.h"
+#include "ShaderDefines.h"
+#include "ShaderSources.h"
+#include "SimulationConstants.h"
+#include "Snapshot.h"
+#include "UniformRing.h"
 
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <random>
+#include <memory>
+#include <string>
+#include <utility>
 #if defined(FHL_PLATFORM_WINDOWS)
 #include <windows.h>
 #endif
 
-const char * const CS_SRC = "\
-#version 430 core\n\
-layout(local_size_x = 64) in;\n\
-layout(std140, binding = 0) restrict buffer Pos {\n\
-	vec4 position[];\n\
-};\n\
-layout(std140, binding = 1) restrict buffer Vel {\n\
-	vec4 velocity[];\n\
-};\n\
-layout(location = 0) uniform float dt;\n\
-layout(location = 1) uniform bool attractorActive;\n\
-layout(location = 2) uniform vec3 attractorPosition;\n\
-\n\
-void main() {\n\
-	const uint idx = gl_GlobalInvocationID.x;\n\
-	velocity[idx] *= 1 - .99f * dt;\n\
-	if (attractorActive) {\n\
-		float dist = distance(attractorPosition, position[idx].xyz);\n\
-		float acc = 10000.f / max(1.f, 0.01f * pow(dist, 1.5f));\n\
-		velocity[idx] += vec4(normalize(attractorPosition - position[idx].xyz), 0.f) * acc * dt;\n\
-	}\n\
-	position[idx] += velocity[idx] * dt;\n\
-}\
-";
-
-const char * const VS_SRC = "\
-#version 430 core\n\
-layout(location = 0) in vec4 position;\n\
-layout(location = 1) in vec4 velocity;\n\
-layout(location = 0) uniform mat4 view;\n\
-out vec3 vs_color;\n\
-const vec3 LO_COLOR = vec3(0xb3, 0xd9, 0xff)/255.f, HI_COLOR = vec3(0xff, 0, 0x66)/255.f;\n\
-\n\
-void main() {\n\
-	vs_color = mix(LO_COLOR, HI_COLOR, smoothstep(0.f, 700.f, length(velocity.xyz)));\n\
-	gl_Position = view * vec4(position.xyz, 1.f);\n\
-}\
-";
-
-const char * const GS_SRC = "\
-#version 430 core\n\
-layout(points) in;\n\
-layout(triangle_strip, max_vertices = 4) out;\n\
-\n\
-in vec3 vs_color[];\n\
-out vec3 fs_color;\n\
-out vec2 fs_txCoords;\n\
-\n\
-layout(location = 1) uniform mat4 projection;\n\
-const vec2 offsets[4] = {\n\
-	vec2(0.f, 0.f), vec2(1.f, 0.f), vec2(0.f, 1.f), vec2(1.f, 1.f) };\n\
-\n\
-void main() {\n\
-	fs_color = vs_color[0];\n\
-	for (int i = 0; i < 4; ++i) {\n\
-		fs_txCoords = offsets[i];\n\
-		vec4 pos = gl_in[0].gl_Position;\n\
-		pos.xy += .5f * (offsets[i] - vec2(0.5f));\n\
-		gl_Position = projection * pos;\n\
-		EmitVertex();\n\
-	}\n\
-}\
-";
-
-const char * const FS_SRC = "\
-#version 430 core\n\
-in vec3 fs_color;\n\
-in vec2 fs_txCoords;\n\
-out vec4 color;\n\
-layout(location = 2) uniform sampler2D txSampler;\n\
-\n\
-void main() {\n\
-	color = texture(txSampler, fs_txCoords) * vec4(fs_color, 1.f);\n\
-}\
-";
-
 const char * const PARTICLE_TEXTURE_PATH = "particle.tga";
+const char * const SHADER_DIRECTORY = "shaders";
+const char * const SHADER_FILES[] = {
+	"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "free_list.glsl", "emitters.glsl", "force_fields.glsl", "simulate.comp", "emit_prepare.comp", "emit.comp",
+	"compact.glsl", "compact_count.comp", "compact_scan.comp", "compact_scatter.comp", "compact_move.comp", "compact_finalize.comp",
+	"compact_keys.comp", "compact_order.comp", "radix_sort.glsl", "radix_count.comp", "radix_scan.comp", "radix_scatter.comp", "spatial_hash.glsl", "hash_keys.comp", "hash_cells.comp", "interact.comp",
+	"morton.glsl", "barnes_hut.glsl", "bh_keys.comp", "bh_tree.comp", "bh_summarize.comp", "gravity.comp",
+	"particle_mesh.glsl", "pm_deposit.comp", "pm_fft.comp", "pm_solve.comp", "pm_force.comp", "cull.comp",
+	"frame_params.glsl", "visible_index.glsl", "render_position.glsl", "particle.vert", "particle.geom", "particle_pull.vert", "particle.frag" };
+
+enum Bindings { PositionBuffer = 0, VelocityBuffer = 1, PrevPositionBuffer = 4 };
+enum UniformBlockBindings { FrameParamsBlock = 1 };
+
+// std140 FrameParams block of frame_params.glsl
+struct FrameUniforms
+{
+	fhl::Mat4f view;
+	fhl::Mat4f projection;
+	float alpha;
+	float padding[3];
+};
+static_assert(sizeof(FrameUniforms) == 144, "FrameUniforms must match the std140 layout of FrameParams");
+enum AttrLoc { Position = 0, Velocity = 1, PrevPosition = 2, Life = 3 };
 
-enum Bindings { PositionBuffer = 0, VelocityBuffer = 1 };
-enum CsUniformLoc { DeltaTime = 0, AttractorActive = 1, AttractorPosition = 2 };
-enum GeneralShaderUniformLoc { View = 0, Projection = 1, Texture = 2 };
-enum AttrLoc { Position = 0, Velocity = 1 };
-
-GLuint makeCs(const char * const _src);
-GLuint makeGeneralShader(const char * const _vs, const char * const _gs, const char * const _fs);
 GLuint loadTexture(const char * const _path);
+bool saveFrame(const char * const _path, const fhl::Vec2u & _size);
 
 void checkErrors();
 
 #if defined(FHL_PLATFORM_WINDOWS)
 int __stdcall WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 #else
-int main(int, char**)
+int main(int argc, char ** argv)
 #endif
 {
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-	glfwWindowHint(GLFW_RESIZABLE, 0);
+#if defined(FHL_PLATFORM_WINDOWS)
+	const Options options = Options::parse(__argc, __argv);
+#else
+	const Options options = Options::parse(argc, argv);
+#endif
+	if (options.tracePath)
+	{
+		fhl::trace::enable();
+		fhl::trace::setThreadName("main");
+	}
 
 	const fhl::Vec2u WIN_SIZE{1280, 720u};
-	auto window = glfwCreateWindow(WIN_SIZE.x(), WIN_SIZE.y(), "particles", NULL, NULL);
-	glfwMakeContextCurrent(window);
+	GLFWwindow * window = nullptr;
+	HeadlessContext headlessContext;
+	if (options.headless)
+	{
+		if (!headlessContext.create())
+			return 1;
+	}
+	else
+	{
+		glfwInit();
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		glfwWindowHint(GLFW_RESIZABLE, 0);
+
+		window = glfwCreateWindow(WIN_SIZE.x(), WIN_SIZE.y(), "particles", NULL, NULL);
+		glfwMakeContextCurrent(window);
 
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	}
 
 	// load GL functions
-	flextGLInit();
+	if (options.eagerGl)
+		flextGLInit();
+	else
+		flextGLInitLazy();
+
+	std::unique_ptr<ProgramCache> programCache;
+	if (options.shaderCachePath)
+		programCache = std::make_unique<ProgramCache>(options.shaderCachePath);
+
+	ShaderSources shaderSources{SHADER_DIRECTORY};
+	for (const char * name : SHADER_FILES)
+		if (!shaderSources.load(name))
+			return 1;
+	std::unique_ptr<fhl::FileWatcher> shaderWatcher;
+	if (options.shaderReload)
+	{
+		shaderWatcher = std::make_unique<fhl::FileWatcher>(SHADER_DIRECTORY, std::vector<std::string>(std::begin(SHADER_FILES), std::end(SHADER_FILES)));
+		std::printf("Watching %s for changes (%s)\n", SHADER_DIRECTORY, shaderWatcher->usesInotify() ? "inotify" : "polling");
+	}
+	// every subsystem registers its programs as a group, rebuilt as a whole when one of its files changes
+	ProgramGroups programGroups{shaderSources, programCache.get()};
+
+	// headless frames go to an offscreen framebuffer of the window size
+	GLuint fbo{}, colorBuffer{};
+	if (!window)
+	{
+		glCreateRenderbuffers(1, &colorBuffer);
+		glNamedRenderbufferStorage(colorBuffer, GL_RGBA8, WIN_SIZE.x(), WIN_SIZE.y());
+		glCreateFramebuffers(1, &fbo);
+		glNamedFramebufferRenderbuffer(fbo, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+		glViewport(0, 0, WIN_SIZE.x(), WIN_SIZE.y());
+	}
 
 	std::srand(997);
 
 	const std::size_t PARTICLE_CNT = 1u << 21; // ~2M
 	const float GRAVITY_POINT_DISTANCE_FROM_CAM = 800.f;
 
-	std::vector<fhl::Vec4f> positions;
-	positions.reserve(PARTICLE_CNT);
-	for (float x = 0; x < (1u << 7); ++x)
-		for (float y = 0; y < (1u << 7); ++y)
-			for (float z = 0; -z < (1u << 7); --z)
-				positions.push_back(fhl::Vec4f{x, y, z, 1.f});
-	std::vector<fhl::Vec4f> velocities(PARTICLE_CNT, fhl::Vec4f::zero());
+	std::unique_ptr<RecordingReader> replay;
+	if (options.replayPath)
+	{
+		replay = std::make_unique<RecordingReader>();
+		if (!replay->open(options.replayPath))
+			replay.reset();
+		else if (replay->getInfo().particleCount != PARTICLE_CNT || !replay->getFrameCount())
+		{
+			std::printf("Recording %s has %zu particles in %zu frames, expected %zu particles\n",
+				options.replayPath, replay->getInfo().particleCount, replay->getFrameCount(), PARTICLE_CNT);
+			replay.reset();
+		}
+	}
+
+	ParticleStorage particles{PARTICLE_CNT};
+	std::uint64_t simulationStep = 0u;
+	bool loaded = replay != nullptr;
+	if (options.loadSnapshot && !replay)
+	{
+		SnapshotReader snapshot;
+		if (snapshot.open(options.loadSnapshot, options.readSnapshot ? SnapshotReader::Access::Read : SnapshotReader::Access::Map))
+		{
+			const SnapshotInfo & info = snapshot.getInfo();
+			if (info.particleCount != PARTICLE_CNT)
+				std::printf("Snapshot %s has %zu particles, expected %zu\n", options.loadSnapshot, info.particleCount, PARTICLE_CNT);
+			else
+			{
+				particles.loadState(info.layout, snapshot.getPositions(), snapshot.getVelocities(), 0u, PARTICLE_CNT);
+				simulationStep = info.step;
+				loaded = true;
+				std::printf("Loaded snapshot %s at step %llu\n", options.loadSnapshot, (unsigned long long)simulationStep);
+				if (info.timestep != options.timestep)
+					std::printf("Snapshot was simulated with timestep %g s, running with %g s\n", info.timestep, options.timestep);
+			}
+		}
+	}
+	if (!loaded)
+	{
+		std::size_t particleIdx = 0u;
+		for (float x = 0; x < (1u << 7); ++x)
+			for (float y = 0; y < (1u << 7); ++y)
+				for (float z = 0; -z < (1u << 7); --z)
+					particles.set(particleIdx++, fhl::Vec3f{x, y, z}, fhl::Vec3f::zero());
+	}
+
+	const StateLayout stateLayout = replay ? replay->getInfo().layout : options.compactState ? StateLayout::Compact : StateLayout::Vec4;
+	std::vector<unsigned char> positions(PARTICLE_CNT * getPositionStride(stateLayout));
+	std::vector<unsigned char> velocities(PARTICLE_CNT * getVelocityStride(stateLayout));
+	if (replay)
+		replay->readFrame(0u, positions.data(), velocities.data());
+	else
+		particles.storeState(stateLayout, positions.data(), velocities.data(), 0u, PARTICLE_CNT);
 
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
 	glDisable(GL_DEPTH_TEST);
 
-	GLuint posBuffer{}, velBuffer{};
+	std::unique_ptr<fhl::FixedTimestep> timestep;
+	if (options.timestep > 0.f)
+	{
+		timestep = std::make_unique<fhl::FixedTimestep>(options.timestep, options.maxSubsteps);
+		std::printf("Fixed timestep: %g s, up to %u steps per frame\n", options.timestep, options.maxSubsteps);
+	}
+	// positions before the last step are kept for blending with the current ones
+	const bool interpolation = timestep && options.interpolation;
+
+	GLuint posBuffer{}, velBuffer{}, prevPosBuffer{};
 	glCreateBuffers(1, &posBuffer);
 	glCreateBuffers(1, &velBuffer);
 
-	glNamedBufferStorage(posBuffer, positions.size() * sizeof(fhl::Vec4f), positions.data(), GL_DYNAMIC_STORAGE_BIT);
-	glNamedBufferStorage(velBuffer, velocities.size() * sizeof(fhl::Vec4f), velocities.data(), GL_DYNAMIC_STORAGE_BIT);
-	positions.clear();
-	velocities.clear();
+	glNamedBufferStorage(posBuffer, positions.size(), positions.data(), GL_DYNAMIC_STORAGE_BIT);
+	glNamedBufferStorage(velBuffer, velocities.size(), velocities.data(), GL_DYNAMIC_STORAGE_BIT);
+	if (interpolation)
+	{
+		glCreateBuffers(1, &prevPosBuffer);
+		glNamedBufferStorage(prevPosBuffer, positions.size(), positions.data(), GL_DYNAMIC_STORAGE_BIT);
+	}
+
+	// emitters spawn into systems of their own, taken from the end of the grid; pools have 10% headroom for particles expiring within a step
+	std::size_t emitterCount = std::min<std::size_t>(options.emitterCount, ParticleSpawner::MaxEmitters);
+	const std::size_t emitterCapacity = std::max<std::size_t>(std::size_t(std::ceil(options.emitRate * options.particleLifetime * 1.1f)), 1u);
+	if (emitterCount)
+	{
+		GLint ssboBindings{};
+		glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &ssboBindings);
+		if (replay || options.cpuSimulation)
+		{
+			std::printf("Emitters need GPU simulation, ignoring --emitters\n");
+			emitterCount = 0u;
+		}
+		else if (ssboBindings <= ParticleSpawner::SpawnBuffer)
+		{
+			std::printf("Not enough shader storage buffer bindings for emitters, ignoring --emitters\n");
+			emitterCount = 0u;
+		}
+		else if (emitterCount * emitterCapacity > PARTICLE_CNT / 2u)
+		{
+			emitterCount = PARTICLE_CNT / 2u / emitterCapacity;
+			std::printf("Emitter pools of %zu particles may take half of the particles, using %zu emitters\n", emitterCapacity, emitterCount);
+		}
+	}
+	const bool lifetimes = emitterCount > 0u;
+
+	// one simulation variant per attractor state, so the kernel never branches on it
+	ShaderDefines csDefines;
+	csDefines.append(getStateLayoutDefines(stateLayout))
+		.define("DAMPING", constants::DAMPING)
+		.define("ATTRACTOR_ACCELERATION", constants::ATTRACTOR_ACCELERATION)
+		.define("ATTRACTOR_FALLOFF", constants::ATTRACTOR_FALLOFF)
+		.define("MAX_FORCE_FIELDS", int(GlParticleSimulator::MaxForceFields))
+		.define("FORCE_FIELD_MIN_DISTANCE", constants::FORCE_FIELD_MIN_DISTANCE);
+	if (lifetimes)
+		csDefines.define("LIFETIME");
+	ShaderDefines attractorCsDefines = csDefines;
+	attractorCsDefines.define("ATTRACTOR");
+	// both variants or neither, they must stay in sync
+	const auto makeSimulationPrograms = [&](ProgramGroups::Builder & _builder) {
+		const auto makeSimulationCs = [&](const ShaderDefines & _defines) {
+			return _builder.compute(_defines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "free_list.glsl", "force_fields.glsl", "simulate.comp"});
+		};
+		return std::make_pair(makeSimulationCs(csDefines), makeSimulationCs(attractorCsDefines));
+	};
+	ShaderDefines spawnDefines;
+	spawnDefines.append(getStateLayoutDefines(stateLayout))
+		.define("LIFETIME")
+		.define("MAX_EMITTERS", int(ParticleSpawner::MaxEmitters));
+	if (interpolation) // spawned particles must not be blended with the state before they were spawned
+		spawnDefines.define("INTERPOLATE");
+	// both or neither, they share the spawn table
+	const auto makeSpawnPrograms = [&](ProgramGroups::Builder & _builder) {
+		const auto makeSpawnCs = [&](const char * _name) {
+			return _builder.compute(spawnDefines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "free_list.glsl", "emitters.glsl", _name});
+		};
+		return std::make_pair(makeSpawnCs("emit_prepare.comp"), makeSpawnCs("emit.comp"));
+	};
+	const ShaderDefines sortDefines;
+	const auto makeSortPrograms = [&](ProgramGroups::Builder & _builder) {
+		const auto makeRadixCs = [&](const char * _name) { return _builder.compute(sortDefines, {"radix_sort.glsl", _name}); };
+		return GlRadixSort::Programs{makeRadixCs("radix_count.comp"), makeRadixCs("radix_scan.comp"), makeRadixCs("radix_scatter.comp")};
+	};
+	ShaderDefines compactDefines;
+	compactDefines.append(getStateLayoutDefines(stateLayout));
+	if (lifetimes)
+		compactDefines.define("LIFETIME");
+	// all passes or none, they share the intermediate buffers
+	const auto makeCompactPrograms = [&](ProgramGroups::Builder & _builder) {
+		const auto makeCompactCs = [&](const char * _name) {
+			return _builder.compute(compactDefines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "free_list.glsl", "compact.glsl", _name});
+		};
+		GlParticleCompactor::Programs programs{};
+		programs.count = makeCompactCs("compact_count.comp");
+		programs.scan = makeCompactCs("compact_scan.comp");
+		programs.scatter = makeCompactCs("compact_scatter.comp");
+		programs.move = makeCompactCs("compact_move.comp");
+		programs.finalize = makeCompactCs("compact_finalize.comp");
+		if (options.mortonOrder)
+		{
+			programs.keys = _builder.compute(compactDefines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "free_list.glsl", "compact.glsl",
+				"morton.glsl", "compact_keys.comp"});
+			programs.order = makeCompactCs("compact_order.comp");
+			programs.sort = makeSortPrograms(_builder);
+		}
+		return programs;
+	};
+	ShaderDefines hashDefines;
+	hashDefines.append(getStateLayoutDefines(stateLayout))
+		.define("INTERACTION_RADIUS", options.interactionRadius)
+		.define("INTERACTION_REPULSION", constants::INTERACTION_REPULSION)
+		.define("INTERACTION_COHESION", constants::INTERACTION_COHESION)
+		.define("INTERACTION_MAX_NEIGHBOURS", constants::INTERACTION_MAX_NEIGHBOURS)
+		.define("HASH_CELL_BITS", constants::HASH_CELL_BITS);
+	if (lifetimes)
+		hashDefines.define("LIFETIME");
+	const auto makeHashCs = [&](ProgramGroups::Builder & _builder, const char * _name) {
+		return _builder.compute(hashDefines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "spatial_hash.glsl", _name});
+	};
+	// all stages or none, they share the intermediate buffers
+	const auto makeHashPrograms = [&](ProgramGroups::Builder & _builder) {
+		return GlSpatialHash::Programs{makeHashCs(_builder, "hash_keys.comp"), makeHashCs(_builder, "hash_cells.comp"), makeSortPrograms(_builder)};
+	};
+	ShaderDefines gravityDefines;
+	gravityDefines.append(getStateLayoutDefines(stateLayout))
+		.define("GRAVITY_CONSTANT", constants::GRAVITY_CONSTANT)
+		.define("GRAVITY_SOFTENING", constants::GRAVITY_SOFTENING);
+	if (lifetimes)
+		gravityDefines.define("LIFETIME");
+	// all stages or none, they share the tree buffers
+	const auto makeTreePrograms = [&](ProgramGroups::Builder & _builder) {
+		const auto makeTreeCs = [&](const char * _name) {
+			return _builder.compute(gravityDefines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "morton.glsl", "barnes_hut.glsl", _name});
+		};
+		return GlBarnesHut::Programs{makeTreeCs("bh_keys.comp"), makeTreeCs("bh_tree.comp"), makeTreeCs("bh_summarize.comp"), makeTreeCs("gravity.comp"), makeSortPrograms(_builder)};
+	};
+	int meshBits = 0;
+	while ((1u << meshBits) < options.meshSize)
+		++meshBits;
+	ShaderDefines meshDefines = gravityDefines;
+	meshDefines.define("PM_GRID_BITS", meshBits)
+		.define("PM_MASS_SCALE", constants::PM_MASS_SCALE);
+	ShaderDefines meshLoadDefines = meshDefines;
+	meshLoadDefines.define("PM_LOAD_DENSITY");
+	// all stages or none, they share the grid buffers
+	const auto makeMeshPrograms = [&](ProgramGroups::Builder & _builder) {
+		const auto makeMeshCs = [&](const ShaderDefines & _defines, const char * _name) {
+			return _builder.compute(_defines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "particle_mesh.glsl", _name});
+		};
+		return GlParticleMesh::Programs{makeMeshCs(meshDefines, "pm_deposit.comp"), makeMeshCs(meshLoadDefines, "pm_fft.comp"), makeMeshCs(meshDefines, "pm_fft.comp"),
+			makeMeshCs(meshDefines, "pm_solve.comp"), makeMeshCs(meshDefines, "pm_force.comp")};
+	};
+
+	// systems split the particles evenly, with attractor response from 0.5 to 1.5
+	std::unique_ptr<ParticleSystemManager> systems = std::make_unique<ParticleSystemManager>(PARTICLE_CNT);
+	{
+		const std::size_t gridCapacity = PARTICLE_CNT - emitterCount * (emitterCapacity + ParticleSystemManager::GroupSize);
+		const std::size_t systemCount = std::max(options.systemCount, 1u);
+		const std::size_t systemCapacity = systemCount == 1u ? gridCapacity : gridCapacity / systemCount / ParticleSystemManager::GroupSize * ParticleSystemManager::GroupSize;
+		for (std::size_t i = 0u; i < systemCount; ++i)
+			if (!systems->add(systemCapacity, systemCount == 1u ? 1.f : .5f + float(i) / (systemCount - 1u)))
+			{
+				std::printf("Only %zu particle systems fit\n", i);
+				break;
+			}
+		if (systemCount > 1u)
+			std::printf("%zu particle systems of %zu particles\n", systems->getSystemCount(), systemCapacity);
+	}
+
+	// per-frame shader parameters, written once into a slice of a persistently mapped buffer the GPU isn't reading;
+	// slices hold the worst frame: every step simulates, spawns and runs the enabled passes, then one compaction of up to
+	// four attributes, culling and the frame parameters
+	std::unique_ptr<UniformRing> uniformRing;
+	{
+		UniformUsage stepUniforms = GlParticleSimulator::getUniformUsage();
+		if (lifetimes)
+			stepUniforms = stepUniforms + ParticleSpawner::getUniformUsage();
+		if (options.interactionRadius > 0.f)
+			stepUniforms = stepUniforms + GlSpatialHash::getUniformUsage();
+		if (options.gravity == GravitySolver::BarnesHut)
+			stepUniforms = stepUniforms + GlBarnesHut::getUniformUsage();
+		else if (options.gravity == GravitySolver::ParticleMesh)
+			stepUniforms = stepUniforms + GlParticleMesh::getUniformUsage();
+		const UniformUsage frameUniforms = stepUniforms * std::max(timestep ? options.maxSubsteps : 1u, 1u)
+			+ GlParticleCompactor::getUniformUsage(4u, options.mortonOrder) + FrustumCuller::getUniformUsage() + UniformUsage{1u, sizeof(FrameUniforms)};
+		uniformRing = std::make_unique<UniformRing>(frameUniforms);
+	}
+
+	GlParticleSimulator * glSimulator{};
+	std::vector<unsigned char> prevPositions;
+	std::unique_ptr<fhl::ThreadPool> threadPool;
+	std::unique_ptr<ParticleSimulator> simulator;
+	CpuParticleSimulator * cpuSimulator{};
+	if (replay)
+	{
+		positions = std::vector<unsigned char>();
+		velocities = std::vector<unsigned char>();
+		simulator = std::make_unique<ReplayParticleSimulator>(*replay, posBuffer, velBuffer);
+		std::printf("Replaying %s: %zu frames\n", options.replayPath, replay->getFrameCount());
+	}
+	else if (options.cpuSimulation)
+	{
+		threadPool = std::make_unique<fhl::ThreadPool>(options.threadCount);
+		auto cpuSim = std::make_unique<CpuParticleSimulator>(std::move(particles), *systems, *threadPool, options.kernelIsa);
+		cpuSimulator = cpuSim.get();
+		if (interpolation)
+			prevPositions.resize(positions.size());
+		simulator = std::move(cpuSim);
+		std::printf("CPU simulation: %u threads, %s kernel\n", threadPool->getThreadCount(), toString(cpuSimulator->getKernelIsa()));
+	}
+	else
+	{
+		positions = std::vector<unsigned char>();
+		velocities = std::vector<unsigned char>();
+		const std::pair<GLuint, GLuint> programs = programGroups.add("simulation", makeSimulationPrograms,
+			[&](const std::pair<GLuint, GLuint> & _programs) { glSimulator->setPrograms(_programs.first, _programs.second); });
+		auto glSim = std::make_unique<GlParticleSimulator>(programs.first, programs.second, *systems, *uniformRing);
+		glSimulator = glSim.get();
+		simulator = std::move(glSim);
+	}
+
+	std::unique_ptr<ParticleSpawner> spawner;
+	if (lifetimes)
+	{
+		const std::pair<GLuint, GLuint> programs = programGroups.add("spawn", makeSpawnPrograms,
+			[&](const std::pair<GLuint, GLuint> & _programs) { spawner->setPrograms(_programs.first, _programs.second); });
+		spawner = std::make_unique<ParticleSpawner>(programs.first, programs.second, *systems, *uniformRing);
+		// evenly spaced on a circle around the middle of the grid
+		const float EMITTER_SPEED = 8.f, EMITTER_CIRCLE_RADIUS = 48.f;
+		for (std::size_t i = 0u; i < emitterCount; ++i)
+		{
+			const float angle = 6.2831853f * i / emitterCount;
+			const fhl::Vec3f position{64.f + EMITTER_CIRCLE_RADIUS * std::cos(angle), 64.f, -64.f + EMITTER_CIRCLE_RADIUS * std::sin(angle)};
+			if (systems->add(emitterCapacity))
+				spawner->addEmitter(systems->getSystemCount() - 1u, position, options.emitRate, EMITTER_SPEED, options.particleLifetime);
+		}
+		std::printf("%zu emitters of %g particles/s living %g s\n", spawner->getEmitterCount(), options.emitRate, options.particleLifetime);
+	}
+
+	// force fields on a circle around the middle of the grid, taking turns at point (alternately attracting and repelling), vortex, wind and turbulence
+	std::vector<ForceField> forceFields;
+	const float TURBULENCE_PHASE_SPEED = 1.f; // radians per second
+	{
+		const float FIELD_CIRCLE_RADIUS = 64.f;
+		const std::size_t fieldCount = std::min<std::size_t>(options.forceFieldCount, GlParticleSimulator::MaxForceFields);
+		for (std::size_t i = 0u; i < fieldCount; ++i)
+		{
+			const float angle = 6.2831853f * i / fieldCount;
+			const fhl::Vec3f position{64.f + FIELD_CIRCLE_RADIUS * std::cos(angle), 64.f, -64.f + FIELD_CIRCLE_RADIUS * std::sin(angle)};
+			switch (i % 4u)
+			{
+			case 0u: forceFields.push_back(ForceField{ForceField::Type::Point, position, fhl::Vec3f{0.f, 1.f, 0.f}, i / 4u % 2u ? -400.f : 400.f, 24.f}); break;
+			case 1u: forceFields.push_back(ForceField{ForceField::Type::Vortex, position, fhl::Vec3f{0.f, 1.f, 0.f}, 200.f, 32.f}); break;
+			case 2u: forceFields.push_back(ForceField{ForceField::Type::Wind, position, fhl::Vec3f{-std::sin(angle), 0.f, std::cos(angle)}, 10.f, 0.f}); break;
+			default: forceFields.push_back(ForceField{ForceField::Type::Turbulence, position, fhl::Vec3f{0.f, 1.f, 0.f}, 40.f, 8.f}); break;
+			}
+		}
+		if (options.forceFieldCount > fieldCount)
+			std::printf("Only %zu force fields are supported\n", fieldCount);
+	}
+
+	// dead particles and ones outside the kill sphere are packed out of the ranges in use every compactInterval steps, possibly sorted
+	const fhl::Vec3f KILL_CENTER{64.f, 64.f, -64.f};
+	const float killRadius = options.killRadius > 0.f ? options.killRadius : std::numeric_limits<float>::infinity();
+	// Morton codes and the gravity solvers cover a 1024 wide cube around the middle of the grid
+	const fhl::Vec3f SPATIAL_DOMAIN_MIN{KILL_CENTER.x() - 512.f, KILL_CENTER.y() - 512.f, KILL_CENTER.z() - 512.f};
+	const float SPATIAL_DOMAIN_SIZE = 1024.f;
+	std::unique_ptr<GlParticleCompactor> compactor;
+	std::vector<GlParticleCompactor::Attribute> compactAttributes;
+	bool compaction = options.compactInterval && (options.killRadius > 0.f || lifetimes || options.mortonOrder) && !replay;
+	if (compaction && glSimulator)
+	{
+		GLint ssboBindings{};
+		glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &ssboBindings);
+		if (ssboBindings <= GlParticleCompactor::MoveScratchBuffer)
+		{
+			std::printf("Not enough shader storage buffer bindings for compaction, particles are never packed\n");
+			compaction = false;
+		}
+		else
+		{
+			compactor = std::make_unique<GlParticleCompactor>(programGroups.add("compaction", makeCompactPrograms,
+				[&](const GlParticleCompactor::Programs & _programs) { compactor->setPrograms(_programs); }), *systems, *uniformRing);
+			// every per particle buffer moves along
+			compactAttributes = {{posBuffer, getPositionStride(stateLayout)}, {velBuffer, getVelocityStride(stateLayout)}};
+			if (spawner)
+				compactAttributes.push_back({spawner->getLifeBuffer(), sizeof(float)});
+			if (interpolation)
+				compactAttributes.push_back({prevPosBuffer, getPositionStride(stateLayout)});
+			if (options.mortonOrder)
+				compactor->setMortonOrder(SPATIAL_DOMAIN_MIN, SPATIAL_DOMAIN_SIZE);
+		}
+	}
+	if (compaction && cpuSimulator && options.mortonOrder)
+		cpuSimulator->setMortonOrder(SPATIAL_DOMAIN_MIN, SPATIAL_DOMAIN_SIZE);
+	std::uint64_t nextCompactionStep = simulationStep + options.compactInterval;
+
+	std::unique_ptr<GlSpatialHash> spatialHash;
+	if (options.interactionRadius > 0.f)
+	{
+		GLint ssboBindings{};
+		glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &ssboBindings);
+		if (replay)
+			std::printf("Replays are not simulated, ignoring --interaction-radius\n");
+		else if (cpuSimulator)
+			cpuSimulator->setInteractionRadius(options.interactionRadius);
+		else if (ssboBindings <= GlSpatialHash::CellBuffer)
+			std::printf("Not enough shader storage buffer bindings for the hash grid, ignoring --interaction-radius\n");
+		else
+		{
+			spatialHash = std::make_unique<GlSpatialHash>(programGroups.add("hash grid", makeHashPrograms,
+				[&](const GlSpatialHash::Programs & _programs) { spatialHash->setPrograms(_programs); }), *systems, *uniformRing);
+			const auto setInteraction = [&](GLuint _program) { glSimulator->setInteraction(_program, spatialHash.get()); };
+			setInteraction(programGroups.add("interaction", [&](ProgramGroups::Builder & _builder) { return makeHashCs(_builder, "interact.comp"); }, setInteraction));
+		}
+	}
+
+	std::unique_ptr<GlBarnesHut> barnesHut;
+	std::unique_ptr<GlParticleMesh> particleMesh;
+	if (options.gravity != GravitySolver::None)
+	{
+		const bool tree = options.gravity == GravitySolver::BarnesHut;
+		GLint ssboBindings{};
+		glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &ssboBindings);
+		if (replay)
+			std::printf("Replays are not simulated, ignoring --gravity\n");
+		else if (cpuSimulator && tree)
+			cpuSimulator->setGravity(std::make_unique<CpuBarnesHut>(cpuSimulator->getParticleCount(), SPATIAL_DOMAIN_MIN, SPATIAL_DOMAIN_SIZE, options.openingAngle, *threadPool));
+		else if (cpuSimulator)
+			cpuSimulator->setGravity(std::make_unique<CpuParticleMesh>(SPATIAL_DOMAIN_MIN, SPATIAL_DOMAIN_SIZE, options.meshSize, *threadPool));
+		else if (ssboBindings <= (tree ? int(GlBarnesHut::VisitBuffer) : int(GlParticleMesh::FieldBuffer)))
+			std::printf("Not enough shader storage buffer bindings for the gravity solver, ignoring --gravity\n");
+		else if (tree)
+		{
+			barnesHut = std::make_unique<GlBarnesHut>(programGroups.add("Barnes-Hut", makeTreePrograms,
+				[&](const GlBarnesHut::Programs & _programs) { barnesHut->setPrograms(_programs); }), *systems, *uniformRing, SPATIAL_DOMAIN_MIN, SPATIAL_DOMAIN_SIZE, options.openingAngle);
+			glSimulator->setGravity(barnesHut.get());
+		}
+		else
+		{
+			particleMesh = std::make_unique<GlParticleMesh>(programGroups.add("particle-mesh", makeMeshPrograms,
+				[&](const GlParticleMesh::Programs & _programs) { particleMesh->setPrograms(_programs); }), *systems, *uniformRing, SPATIAL_DOMAIN_MIN, SPATIAL_DOMAIN_SIZE, options.meshSize);
+			glSimulator->setGravity(particleMesh.get());
+		}
+	}
+
+	RenderPath renderPath = options.renderPath;
+	bool culling = options.frustumCulling;
+	{
+		GLint vsStorageBlocks{};
+		glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vsStorageBlocks);
+		const GLint prevPosBlocks = interpolation ? 1 : 0;
+		const GLint lifeBlocks = lifetimes ? 1 : 0;
+		if (renderPath == RenderPath::VertexPulling && vsStorageBlocks < 2 + prevPosBlocks + lifeBlocks)
+		{
+			std::printf("Vertex shader storage blocks not supported, falling back to geometry shader rendering\n");
+			renderPath = RenderPath::GeometryShader;
+		}
+		if (culling && vsStorageBlocks < 3 + prevPosBlocks)
+		{
+			std::printf("Not enough vertex shader storage blocks for frustum culling, disabling it\n");
+			culling = false;
+		}
+	}
 
-	GLuint cs = makeCs(CS_SRC);
-	GLuint shader = makeGeneralShader(VS_SRC, GS_SRC, FS_SRC);
+	ShaderDefines renderDefines;
+	renderDefines.append(getStateLayoutDefines(stateLayout))
+		.define("COLOR_MAX_SPEED", constants::COLOR_MAX_SPEED);
+	if (culling)
+		renderDefines.define("CULLING");
+	if (interpolation)
+		renderDefines.define("INTERPOLATE");
+	if (lifetimes)
+		renderDefines.define("LIFETIME");
+
+	const auto makeRenderProgram = [&](ProgramGroups::Builder & _builder) {
+		if (renderPath == RenderPath::VertexPulling)
+			return _builder.render(renderDefines, {"frame_params.glsl", "state_access.glsl", "lifetime.glsl", "visible_index.glsl", "render_position.glsl", "particle_pull.vert"},
+				{}, {"particle.frag"});
+		else if (culling)
+			return _builder.render(renderDefines, {"frame_params.glsl", "state_access.glsl", "lifetime.glsl", "visible_index.glsl", "render_position.glsl", "particle.vert"},
+				{"frame_params.glsl", "particle.geom"}, {"particle.frag"});
+		else
+			return _builder.render(renderDefines, {"frame_params.glsl", "particle.vert"}, {"frame_params.glsl", "particle.geom"}, {"particle.frag"});
+	};
+	ShaderDefines cullDefines;
+	cullDefines.append(getStateLayoutDefines(stateLayout));
+	if (lifetimes)
+		cullDefines.define("LIFETIME");
+	const auto makeCullCs = [&](ProgramGroups::Builder & _builder) {
+		return _builder.compute(cullDefines, {"state_access.glsl", "particle_systems.glsl", "lifetime.glsl", "cull.comp"});
+	};
+
+	GLuint shader{};
+	shader = programGroups.add("render", makeRenderProgram, [&](GLuint _program) { shader = _program; });
+
+	std::unique_ptr<FrustumCuller> culler;
+	if (culling)
+		culler = std::make_unique<FrustumCuller>(programGroups.add("culling", makeCullCs, [&](GLuint _program) { culler->setProgram(_program); }), *systems, *uniformRing);
 
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::PositionBuffer, posBuffer);
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::VelocityBuffer, velBuffer);
+	if (interpolation)
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Bindings::PrevPositionBuffer, prevPosBuffer);
+	systems->bind();
+	if (spawner)
+		spawner->bind();
+
+	const GLenum drawMode = renderPath == RenderPath::VertexPulling ? GL_TRIANGLES : GL_POINTS;
+	const GLuint verticesPerParticle = renderPath == RenderPath::VertexPulling ? 6u : 1u;
 
 	GLuint vao{};
 	glGenVertexArrays(1, &vao);
 	glBindVertexArray(vao);
 
 	glBindBuffer(GL_ARRAY_BUFFER, posBuffer);
-	glVertexAttribPointer(AttrLoc::Position, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(fhl::Vec4f::valueType), (void *)0);
+	if (stateLayout == StateLayout::Compact)
+		glVertexAttribPointer(AttrLoc::Position, 3, GL_FLOAT, GL_FALSE, GLsizei(getPositionStride(stateLayout)), (void *)0);
+	else
+		glVertexAttribPointer(AttrLoc::Position, 4, GL_FLOAT, GL_FALSE, GLsizei(getPositionStride(stateLayout)), (void *)0);
 	glEnableVertexAttribArray(AttrLoc::Position);
 	glBindBuffer(GL_ARRAY_BUFFER, velBuffer);
-	glVertexAttribPointer(AttrLoc::Velocity, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(fhl::Vec4f::valueType), (void *)0);
+	if (stateLayout == StateLayout::Compact) // half floats are unpacked by vertex fetch
+		glVertexAttribPointer(AttrLoc::Velocity, 4, GL_HALF_FLOAT, GL_FALSE, GLsizei(getVelocityStride(stateLayout)), (void *)0);
+	else
+		glVertexAttribPointer(AttrLoc::Velocity, 4, GL_FLOAT, GL_FALSE, GLsizei(getVelocityStride(stateLayout)), (void *)0);
 	glEnableVertexAttribArray(AttrLoc::Velocity);
+	if (interpolation)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, prevPosBuffer);
+		glVertexAttribPointer(AttrLoc::PrevPosition, stateLayout == StateLayout::Compact ? 3 : 4, GL_FLOAT, GL_FALSE, GLsizei(getPositionStride(stateLayout)), (void *)0);
+		glEnableVertexAttribArray(AttrLoc::PrevPosition);
+	}
+	if (spawner)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, spawner->getLifeBuffer());
+		glVertexAttribPointer(AttrLoc::Life, 1, GL_FLOAT, GL_FALSE, GLsizei(sizeof(float)), (void *)0);
+		glEnableVertexAttribArray(AttrLoc::Life);
+	}
 
 	GLuint particleTex = loadTexture(PARTICLE_TEXTURE_PATH);
 	glActiveTexture(GL_TEXTURE0);
@@ -177,135 +665,286 @@ int main(int, char**)
 	CameraController camController({&cam});
 	camController.setTranslationSpeed(10.f);
 
+	std::unique_ptr<RecordingWriter> recorder;
+	if (options.recordPath)
+	{
+		const SnapshotInfo info{PARTICLE_CNT, stateLayout, timestep ? timestep->getStep() : 0.f, simulationStep};
+		recorder = std::make_unique<RecordingWriter>(options.recordPath, info, options.recordQueue, options.keyframeInterval);
+		if (!recorder->isOpen())
+			recorder.reset();
+	}
+	// the GPU state reaches the recorder through staging copies, cpuSimulator exports its own
+	std::unique_ptr<GlStateReadback> readback;
+	if (recorder && !cpuSimulator)
+		readback = std::make_unique<GlStateReadback>(PARTICLE_CNT * getPositionStride(stateLayout), PARTICLE_CNT * getVelocityStride(stateLayout), options.recordQueue);
+
+	std::unique_ptr<GpuProfiler> gpuProfiler;
+	if (options.gpuProfile || options.tracePath) // GPU passes are traced too
+		gpuProfiler = std::make_unique<GpuProfiler>();
+	GpuProfiler * const profiler = gpuProfiler.get();
+	const unsigned GPU_PROFILE_REPORT_FRAMES = 300u;
+
 	std::map<int, int> keyStates;
-	fhl::Clock clock;
-	while (!glfwWindowShouldClose(window))
+	bool snapshotKeyDown = false;
+	bool traceKeyDown = false;
+	const unsigned frameLimit = options.frameCount ? options.frameCount : window ? 0u : 1000u;
+	unsigned frame = 0u;
+	fhl::Clock clock, runClock;
+	while ((!window || !glfwWindowShouldClose(window)) && (!frameLimit || frame < frameLimit))
 	{
-		glClearColor(0.f, 0.f, 0.f, 1.f);
-		glClear(GL_COLOR_BUFFER_BIT);
+		if (shaderWatcher)
+		{ // groups of programs made of changed files are relinked and replace the running ones only if all of them linked
+			std::vector<std::string> changed = shaderWatcher->takeChanged();
+			changed.erase(std::remove_if(changed.begin(), changed.end(), [&](const std::string & _name) { return !shaderSources.load(_name); }), changed.end());
+			if (!changed.empty())
+				programGroups.reload(changed);
+		}
+
+		fhl::trace::Scope frameScope{"frame"};
+		if (profiler)
+		{
+			profiler->beginFrame();
+			profiler->beginPass("frame");
+		}
+
+		{
+			GpuProfiler::Scope pass{profiler, "clear"};
+			glClearColor(0.f, 0.f, 0.f, 1.f);
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
 
-		const float dt = clock.restart();
-		bool mblPressed = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+		const float frameTime = clock.restart();
+		// no input headless, the attractor is held on so that the simulation does work
+		bool mblPressed = !window || glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
 		const fhl::Vec3f attractorPosition = cam.getPosition() + -cam.getDirectionVector() * GRAVITY_POINT_DISTANCE_FROM_CAM * .75f;
 
-		glUseProgram(cs);
-		glUniform1f(CsUniformLoc::DeltaTime, dt);
-		glUniform1i(CsUniformLoc::AttractorActive, mblPressed);
-		glUniform3fv(CsUniformLoc::AttractorPosition, 1, attractorPosition.data());
-		glDispatchCompute(PARTICLE_CNT >> 6, 1, 1);
-		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		if (compaction && simulationStep >= nextCompactionStep)
+		{
+			fhl::trace::Scope compactScope{"compact"};
+			GpuProfiler::Scope pass{profiler, "compact"};
+			if (cpuSimulator)
+			{ // the buffers must be in the new order before interpolation copies positions
+				cpuSimulator->compact(KILL_CENTER, killRadius);
+				cpuSimulator->exportState(stateLayout, positions.data(), velocities.data());
+				glNamedBufferSubData(posBuffer, 0, positions.size(), positions.data());
+				glNamedBufferSubData(velBuffer, 0, velocities.size(), velocities.data());
+				if (interpolation) // the previous positions were in the old order, a frame without steps blends with these instead
+					glCopyNamedBufferSubData(posBuffer, prevPosBuffer, 0, 0, positions.size());
+			}
+			else
+				compactor->compact(KILL_CENTER, killRadius, compactAttributes);
+			nextCompactionStep = simulationStep + options.compactInterval;
+		}
+		systems->upload(verticesPerParticle);
+		const unsigned steps = timestep ? timestep->advance(frameTime) : 1u;
+		const float dt = timestep ? timestep->getStep() : frameTime;
+		for (unsigned i = 0u; i < steps; ++i)
+		{
+			fhl::trace::Scope stepScope{"simulation step"};
+			if (interpolation && i + 1u == steps)
+			{
+				if (cpuSimulator && i > 0u)
+				{
+					cpuSimulator->exportPositions(stateLayout, prevPositions.data());
+					glNamedBufferSubData(prevPosBuffer, 0, prevPositions.size(), prevPositions.data());
+				}
+				else
+				{ // posBuffer holds the state before this step
+					glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+					glCopyNamedBufferSubData(posBuffer, prevPosBuffer, 0, 0, PARTICLE_CNT * getPositionStride(stateLayout));
+				}
+			}
+			{
+				GpuProfiler::Scope pass{profiler, "simulate"};
+				SimulationParams params{dt, mblPressed, attractorPosition};
+				params.forceFields = forceFields.data();
+				params.forceFieldCount = forceFields.size();
+				simulator->update(params);
+			}
+			for (ForceField & field : forceFields)
+				if (field.type == ForceField::Type::Turbulence)
+					field.phase += TURBULENCE_PHASE_SPEED * dt;
+			if (spawner)
+			{
+				fhl::trace::Scope spawnScope{"spawn"};
+				GpuProfiler::Scope pass{profiler, "spawn"};
+				spawner->spawn(dt);
+			}
+			if (recorder)
+			{
+				fhl::trace::Scope recordScope{"record"};
+				if (readback)
+					readback->capture(simulationStep + i + 1u, posBuffer, velBuffer, *recorder);
+				else
+					recorder->record(simulationStep + i + 1u, [&](void * _positions, void * _velocities) {
+						cpuSimulator->exportState(stateLayout, _positions, _velocities);
+					});
+			}
+		}
+		simulationStep += steps;
+		if (readback)
+			readback->flush(*recorder, false);
+		if (cpuSimulator && steps)
+		{
+			fhl::trace::Scope uploadScope{"upload"};
+			GpuProfiler::Scope pass{profiler, "upload"};
+			cpuSimulator->exportState(stateLayout, positions.data(), velocities.data());
+			glNamedBufferSubData(posBuffer, 0, positions.size(), positions.data());
+			glNamedBufferSubData(velBuffer, 0, velocities.size(), velocities.data());
+		}
 
+		const fhl::Mat4f view = cam.getView();
 		glUseProgram(shader);
-		glUniformMatrix4fv(GeneralShaderUniformLoc::View, 1, GL_FALSE, cam.getView().data());
-		glUniformMatrix4fv(GeneralShaderUniformLoc::Projection, 1, GL_FALSE, projection.data());
-		glUniform1i(GeneralShaderUniformLoc::Texture, 0);
+		uniformRing->push(UniformBlockBindings::FrameParamsBlock, FrameUniforms{view, projection, interpolation ? timestep->getAlpha() : 1.f, {}});
 
-		fhl::Vec2lf currentMouse;
-		glfwGetCursorPos(window, &currentMouse.x(), &currentMouse.y());
-		camController.processMousePosition(currentMouse);
+		if (window)
+		{
+			fhl::Vec2lf currentMouse;
+			glfwGetCursorPos(window, &currentMouse.x(), &currentMouse.y());
+			camController.processMousePosition(currentMouse);
+
+			for (int k : {GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D})
+				keyStates[k] = glfwGetKey(window, k);
+			camController.processKeyStates(keyStates);
+			camController.updateAll();
+		}
 
-		for (int k : {GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D})
-			keyStates[k] = glfwGetKey(window, k);
-		camController.processKeyStates(keyStates);
-		camController.updateAll();
+		const bool snapshotKey = window && glfwGetKey(window, GLFW_KEY_F5) == GLFW_PRESS;
+		// snapshots restore every slot as live, they would revive particles compaction removed and the dead ones of emitters
+		if (snapshotKey && !snapshotKeyDown && (compaction || lifetimes))
+			std::printf("Snapshots don't hold per system counts or lifetimes, not saving one with compaction or emitters\n");
+		else if (snapshotKey && !snapshotKeyDown)
+		{
+			const SnapshotInfo info{PARTICLE_CNT, stateLayout, timestep ? timestep->getStep() : 0.f, simulationStep};
+			bool saved = false;
+			if (cpuSimulator)
+			{
+				cpuSimulator->exportState(stateLayout, positions.data(), velocities.data());
+				saved = writeSnapshot(options.snapshotPath, info, positions.data(), velocities.data());
+			}
+			else
+			{
+				std::vector<unsigned char> gpuPositions(PARTICLE_CNT * getPositionStride(stateLayout));
+				std::vector<unsigned char> gpuVelocities(PARTICLE_CNT * getVelocityStride(stateLayout));
+				glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+				glGetNamedBufferSubData(posBuffer, 0, gpuPositions.size(), gpuPositions.data());
+				glGetNamedBufferSubData(velBuffer, 0, gpuVelocities.size(), gpuVelocities.data());
+				saved = writeSnapshot(options.snapshotPath, info, gpuPositions.data(), gpuVelocities.data());
+			}
+			if (saved)
+				std::printf("Saved snapshot %s at step %llu\n", options.snapshotPath, (unsigned long long)simulationStep);
+		}
+		snapshotKeyDown = snapshotKey;
 
-		glDrawArrays(GL_POINTS, 0, PARTICLE_CNT);
+		const bool traceKey = options.tracePath && window && glfwGetKey(window, GLFW_KEY_F7) == GLFW_PRESS;
+		if (traceKey && !traceKeyDown && fhl::trace::write(options.tracePath))
+			std::printf("Saved trace %s\n", options.tracePath);
+		traceKeyDown = traceKey;
 
-		//checkErrors();
+		if (culler)
+		{
+			{
+				fhl::trace::Scope cullScope{"cull"};
+				GpuProfiler::Scope pass{profiler, "cull"};
+				culler->cull(projection * view, verticesPerParticle);
+			}
+			fhl::trace::Scope drawScope{"draw"};
+			GpuProfiler::Scope pass{profiler, "draw"};
+			glUseProgram(shader);
+			culler->draw(drawMode);
+		}
+		else
+		{
+			fhl::trace::Scope drawScope{"draw"};
+			GpuProfiler::Scope pass{profiler, "draw"};
+			systems->draw(drawMode);
+		}
 
-		glfwSwapBuffers(window);
-		glfwPollEvents();
-	}
+		uniformRing->endFrame();
 
-	glDeleteBuffers(1, &posBuffer);
-	glDeleteBuffers(1, &velBuffer);
-	glDeleteVertexArrays(1, &vao);
-	glDeleteTextures(1, &particleTex);
+		//checkErrors();
 
-	glfwTerminate();
-	return 0;
-}
+		if (options.outputPath && frame + 1u == frameLimit)
+			saveFrame(options.outputPath, WIN_SIZE);
+		++frame;
 
-GLuint makeCs(const char * const _src)
-{
-	GLuint program = glCreateProgram();
-	GLuint cs = glCreateShader(GL_COMPUTE_SHADER);
-	glShaderSource(cs, 1, &_src, nullptr);
-	glCompileShader(cs);
-
-	{ // check for compilation errors
-		GLint success{};
-		GLchar infoLog[0x200];
-		glGetShaderiv(cs, GL_COMPILE_STATUS, &success);
-		if (!success)
+		if (window)
+		{
+			fhl::trace::Scope swapScope{"swap"};
+			GpuProfiler::Scope pass{profiler, "swap"};
+			glfwSwapBuffers(window);
+		}
+		if (profiler)
 		{
-			glGetShaderInfoLog(cs, 0x200, nullptr, infoLog);
-			std::printf("CS COMPILATION ERROR: %s\n", infoLog);
-			return 0;
+			profiler->endPass();
+			profiler->endFrame();
+			if (options.gpuProfile && frame % GPU_PROFILE_REPORT_FRAMES == 0u)
+				profiler->printStats();
 		}
+		if (window)
+			glfwPollEvents();
 	}
-	glAttachShader(program, cs);
-	glLinkProgram(program);
-
-	glDetachShader(program, cs);
-	glDeleteShader(cs);
+	glFinish();
+	const float runTime = runClock.getElapsedTime<fhl::Milliseconds>();
+	if (frame)
+		std::printf("%u frames, %.2f ms per frame\n", frame, runTime / frame);
 
-	GLint success;
-	GLchar infoLog[0x200];
-	glGetProgramiv(program, GL_LINK_STATUS, &success);
-	if (!success) {
-		glGetProgramInfoLog(program, 0x200, nullptr, infoLog);
-		printf("CS LINK ERROR: %s\n", infoLog);
+	if (profiler)
+	{
+		profiler->flush();
+		if (options.gpuProfile)
+			profiler->printStats();
 	}
 
-	return program;
-}
+	if (programCache)
+		std::printf("Shader cache: %zu hits, %zu misses\n", programCache->getHits(), programCache->getMisses());
 
-GLuint makeGeneralShader(const char * const _vs, const char * const _gs, const char * const _fs)
-{
-	GLuint program = glCreateProgram();
-	GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vs, 1, &_vs, nullptr);
-	glCompileShader(vs);
-	GLuint gs = glCreateShader(GL_GEOMETRY_SHADER);
-	glShaderSource(gs, 1, &_gs, nullptr);
-	glCompileShader(gs);
-	GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fs, 1, &_fs, nullptr);
-	glCompileShader(fs);
-
-	GLchar infoLog[0x200];
-	for (GLuint s : {vs, gs, fs})
-	{ // check for compilation errors
-		GLint success{};
-		glGetShaderiv(s, GL_COMPILE_STATUS, &success);
-		if (!success)
-		{
-			glGetShaderInfoLog(s, 0x200, nullptr, infoLog);
-			std::printf("VS/GS/FS COMPILATION ERROR: %s", infoLog);
-			return 0;
-		}
+	if (readback)
+	{
+		readback->flush(*recorder, true);
+		if (readback->getStalls())
+			std::printf("Recording waited %zu times for a staging copy\n", readback->getStalls());
+		readback.reset();
+	}
+	if (recorder)
+	{
+		std::printf("Recorded %zu frames (%zu dropped), %.1f MB\n",
+			recorder->getRecordedFrames(), recorder->getDroppedFrames(), recorder->getWrittenBytes() / (1024. * 1024.));
+		recorder.reset();
 	}
-	glAttachShader(program, vs);
-	glAttachShader(program, gs);
-	glAttachShader(program, fs);
-	glLinkProgram(program);
-
-	glDetachShader(program, vs);
-	glDeleteShader(vs);
-	glDetachShader(program, gs);
-	glDeleteShader(gs);
-	glDetachShader(program, fs);
-	glDeleteShader(fs);
 
-	GLint success;
-	glGetProgramiv(program, GL_LINK_STATUS, &success);
-	if (!success) {
-		glGetProgramInfoLog(program, 0x200, nullptr, infoLog);
-		printf("VS/GS/FS LINK ERROR: %s\n", infoLog);
+	if (threadPool)
+	{
+		const auto stats = threadPool->getStats();
+		for (std::size_t i = 0u; i < stats.size(); ++i)
+			std::printf("CPU worker %zu: %zu jobs, %zu chunks (%zu stolen in %zu steals)\n",
+				i, stats[i].jobs, stats[i].chunks, stats[i].stolenChunks, stats[i].steals);
 	}
 
-	return program;
+	if (options.tracePath && fhl::trace::write(options.tracePath))
+		std::printf("Saved trace %s\n", options.tracePath);
+
+	glDeleteBuffers(1, &posBuffer);
+	glDeleteBuffers(1, &velBuffer);
+	glDeleteBuffers(1, &prevPosBuffer);
+	culler.reset();
+	spawner.reset();
+	compactor.reset();
+	spatialHash.reset();
+	barnesHut.reset();
+	particleMesh.reset();
+	gpuProfiler.reset();
+	uniformRing.reset();
+	systems.reset();
+	programGroups.clear();
+	glDeleteVertexArrays(1, &vao);
+	glDeleteTextures(1, &particleTex);
+	glDeleteFramebuffers(1, &fbo);
+	glDeleteRenderbuffers(1, &colorBuffer);
+
+	if (window)
+		glfwTerminate();
+	return 0;
 }
 
 GLuint loadTexture(const char * const _path)
@@ -333,6 +972,24 @@ GLuint loadTexture(const char * const _path)
 	return tex;
 }
 
+bool saveFrame(const char * const _path, const fhl::Vec2u & _size)
+{
+	std::vector<unsigned char> pixels(3u * _size.x() * _size.y());
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, _size.x(), _size.y(), GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+	std::FILE * file = std::fopen(_path, "wb");
+	if (!file)
+	{
+		std::printf("Could not open %s for writing\n", _path);
+		return false;
+	}
+	std::fprintf(file, "P6\n%u %u\n255\n", _size.x(), _size.y());
+	for (unsigned y = _size.y(); y-- > 0u; ) // bottom-up rows
+		std::fwrite(pixels.data() + 3u * _size.x() * y, 1u, 3u * _size.x(), file);
+	return std::fclose(file) == 0;
+}
+
 void checkErrors()
 {
 	GLenum err{};
@@ -0,0 +1,76 @@
+#ifndef FHL_MATHS_HALF_H
+#define FHL_MATHS_HALF_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace fhl
+{
+
+	/* IEEE 754 binary16 conversions, round to nearest even (as GLSL packHalf2x16) */
+	inline std::uint16_t toHalf(float _f)
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &_f, sizeof(bits));
+
+		const std::uint32_t sign = (bits >> 16) & 0x8000u;
+		const std::uint32_t absBits = bits & 0x7fffffffu;
+
+		if (absBits >= 0x7f800000u) // inf or nan
+			return std::uint16_t(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u));
+		if (absBits >= 0x477ff000u) // rounds to a value above max half
+			return std::uint16_t(sign | 0x7c00u);
+		if (absBits < 0x38800000u) // half denormal or zero
+		{
+			if (absBits < 0x33000000u)
+				return std::uint16_t(sign);
+			const std::uint32_t exponent = absBits >> 23;
+			const std::uint32_t mantissa = (absBits & 0x7fffffu) | 0x800000u;
+			const std::uint32_t shift = 126u - exponent;
+			std::uint32_t half = mantissa >> shift;
+			const std::uint32_t rest = mantissa & ((1u << shift) - 1u);
+			const std::uint32_t halfway = 1u << (shift - 1u);
+			if (rest > halfway || (rest == halfway && (half & 1u)))
+				++half;
+			return std::uint16_t(sign | half);
+		}
+
+		std::uint32_t half = ((absBits - 0x38000000u) >> 13);
+		const std::uint32_t rest = absBits & 0x1fffu;
+		if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+			++half;
+		return std::uint16_t(sign | half);
+	}
+
+	inline float fromHalf(std::uint16_t _h)
+	{
+		const std::uint32_t sign = std::uint32_t(_h & 0x8000u) << 16;
+		const std::uint32_t exponent = (_h >> 10) & 0x1fu;
+		std::uint32_t mantissa = _h & 0x3ffu;
+
+		std::uint32_t bits;
+		if (exponent == 0x1fu)
+			bits = sign | 0x7f800000u | (mantissa << 13);
+		else if (exponent)
+			bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+		else if (mantissa)
+		{
+			std::uint32_t e = 113u;
+			while (!(mantissa & 0x400u))
+			{
+				mantissa <<= 1;
+				--e;
+			}
+			bits = sign | (e << 23) | ((mantissa & 0x3ffu) << 13);
+		}
+		else
+			bits = sign;
+
+		float f;
+		std::memcpy(&f, &bits, sizeof(f));
+		return f;
+	}
+
+}
+
+#endif
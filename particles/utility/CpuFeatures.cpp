@@ -0,0 +1,83 @@
+#include "CpuFeatures.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define FHL_CPU_X86 1
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#include <immintrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace fhl
+{
+
+	namespace
+	{
+#if defined(FHL_CPU_X86)
+		void cpuid(unsigned _leaf, unsigned _subleaf, unsigned (&_regs)[4])
+		{
+	#if defined(_MSC_VER)
+			int regs[4];
+			__cpuidex(regs, int(_leaf), int(_subleaf));
+			for (int i = 0; i < 4; ++i)
+				_regs[i] = unsigned(regs[i]);
+	#else
+			__cpuid_count(_leaf, _subleaf, _regs[0], _regs[1], _regs[2], _regs[3]);
+	#endif
+		}
+
+		unsigned long long xgetbv0()
+		{
+	#if defined(_MSC_VER)
+			return _xgetbv(0);
+	#else
+			unsigned eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<unsigned long long>(edx) << 32) | eax;
+	#endif
+		}
+#endif
+
+		CpuFeatures detect()
+		{
+			CpuFeatures f{};
+#if defined(FHL_CPU_X86)
+			unsigned regs[4];
+			cpuid(0u, 0u, regs);
+			const unsigned maxLeaf = regs[0];
+			if (maxLeaf < 1u)
+				return f;
+
+			cpuid(1u, 0u, regs);
+			f.sse2 = (regs[3] & (1u << 26)) != 0u;
+			f.sse41 = (regs[2] & (1u << 19)) != 0u;
+			const bool osxsave = (regs[2] & (1u << 27)) != 0u;
+			const bool cpuAvx = (regs[2] & (1u << 28)) != 0u;
+			const bool cpuFma = (regs[2] & (1u << 12)) != 0u;
+
+			const unsigned long long xcr0 = osxsave ? xgetbv0() : 0u;
+			const bool osAvx = (xcr0 & 0x6u) == 0x6u; // XMM and YMM state
+			const bool osAvx512 = (xcr0 & 0xe6u) == 0xe6u; // plus opmask and ZMM state
+
+			f.avx = cpuAvx && osAvx;
+			f.fma = cpuFma && f.avx;
+			if (maxLeaf >= 7u)
+			{
+				cpuid(7u, 0u, regs);
+				f.avx2 = f.avx && (regs[1] & (1u << 5)) != 0u;
+				f.avx512f = osAvx512 && (regs[1] & (1u << 16)) != 0u;
+			}
+#endif
+			return f;
+		}
+	}
+
+	const CpuFeatures & CpuFeatures::get()
+	{
+		static const CpuFeatures features = detect();
+		return features;
+	}
+
+}
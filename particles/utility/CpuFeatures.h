@@ -0,0 +1,22 @@
+#ifndef FHL_UTILITY_CPU_FEATURES_H
+#define FHL_UTILITY_CPU_FEATURES_H
+
+namespace fhl
+{
+
+	/* Instruction set extensions usable by this process (CPU support and OS-enabled register state) */
+	struct CpuFeatures
+	{
+		bool sse2;
+		bool sse41;
+		bool avx;
+		bool avx2;
+		bool fma;
+		bool avx512f;
+
+		static const CpuFeatures & get();
+	};
+
+}
+
+#endif
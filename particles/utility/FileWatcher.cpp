@@ -0,0 +1,136 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fhl
+{
+
+	FileWatcher::FileWatcher(const std::string & _directory, const std::vector<std::string> & _files, unsigned _pollInterval) :
+		m_directory{_directory},
+		m_pollInterval{_pollInterval},
+		m_inotifyFd{-1},
+		m_stop{false}
+	{
+		for (const std::string & name : _files)
+		{
+			WatchedFile file{name, 0, -1};
+			statFile(name, file.mtime, file.size);
+			m_files.push_back(file);
+		}
+
+#if defined(__linux__)
+		m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotifyFd >= 0 && inotify_add_watch(m_inotifyFd, m_directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		{
+			close(m_inotifyFd);
+			m_inotifyFd = -1;
+		}
+#endif
+		if (usesInotify())
+			m_thread = std::thread(&FileWatcher::watchInotify, this);
+		else
+			m_thread = std::thread(&FileWatcher::watchPolling, this);
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_stop = true;
+		}
+		m_stopCv.notify_all();
+		m_thread.join();
+#if defined(__linux__)
+		if (m_inotifyFd >= 0)
+			close(m_inotifyFd);
+#endif
+	}
+
+	std::vector<std::string> FileWatcher::takeChanged()
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		std::vector<std::string> changed;
+		changed.swap(m_changed);
+		return changed;
+	}
+
+	void FileWatcher::watchInotify()
+	{
+#if defined(__linux__)
+		alignas(inotify_event) char buffer[4096];
+		for (;;)
+		{
+			{
+				std::lock_guard<std::mutex> lock{m_mutex};
+				if (m_stop)
+					return;
+			}
+			// wake up regularly to check for m_stop
+			pollfd fd{m_inotifyFd, POLLIN, 0};
+			if (poll(&fd, 1, int(m_pollInterval)) <= 0)
+				continue;
+
+			ssize_t length;
+			while ((length = read(m_inotifyFd, buffer, sizeof(buffer))) > 0)
+			{
+				for (const char * p = buffer; p < buffer + length; )
+				{
+					const inotify_event * event = reinterpret_cast<const inotify_event *>(p);
+					if (event->len)
+						markChanged(event->name);
+					p += sizeof(inotify_event) + event->len;
+				}
+			}
+		}
+#endif
+	}
+
+	void FileWatcher::watchPolling()
+	{
+		std::unique_lock<std::mutex> lock{m_mutex};
+		while (!m_stopCv.wait_for(lock, std::chrono::milliseconds(m_pollInterval), [this] { return m_stop; }))
+		{
+			lock.unlock();
+			for (WatchedFile & file : m_files)
+			{
+				long long mtime{}, size{};
+				if (statFile(file.name, mtime, size) && (mtime != file.mtime || size != file.size))
+				{
+					file.mtime = mtime;
+					file.size = size;
+					markChanged(file.name);
+				}
+			}
+			lock.lock();
+		}
+	}
+
+	void FileWatcher::markChanged(const std::string & _name)
+	{
+		const bool watched = std::any_of(m_files.begin(), m_files.end(), [&](const WatchedFile & _file) { return _file.name == _name; });
+		if (!watched)
+			return;
+		std::lock_guard<std::mutex> lock{m_mutex};
+		if (std::find(m_changed.begin(), m_changed.end(), _name) == m_changed.end())
+			m_changed.push_back(_name);
+	}
+
+	bool FileWatcher::statFile(const std::string & _name, long long & _mtime, long long & _size) const
+	{
+		struct stat info;
+		if (stat((m_directory + '/' + _name).c_str(), &info) != 0)
+			return false;
+		_mtime = static_cast<long long>(info.st_mtime);
+		_size = static_cast<long long>(info.st_size);
+		return true;
+	}
+
+}
@@ -0,0 +1,60 @@
+#ifndef FHL_UTILITY_FILE_WATCHER_H
+#define FHL_UTILITY_FILE_WATCHER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fhl
+{
+
+	/*
+	 * Reports writes to a set of files in one directory, watched from a background thread.
+	 * Uses inotify on Linux (a file counts as changed once it is closed after writing or renamed over,
+	 * which covers editors that save through a temporary file); elsewhere, or if inotify is unavailable,
+	 * polls modification times every _pollInterval milliseconds.
+	 */
+	class FileWatcher
+	{
+	public:
+		FileWatcher(const std::string & _directory, const std::vector<std::string> & _files, unsigned _pollInterval = 250u);
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher &) = delete;
+		FileWatcher & operator=(const FileWatcher &) = delete;
+
+		bool usesInotify() const { return m_inotifyFd >= 0; }
+
+		/* names of watched files changed since the previous call, each at most once */
+		std::vector<std::string> takeChanged();
+
+	private:
+		struct WatchedFile
+		{
+			std::string name;
+			long long mtime;
+			long long size;
+		};
+
+		void watchInotify();
+		void watchPolling();
+		void markChanged(const std::string & _name);
+		bool statFile(const std::string & _name, long long & _mtime, long long & _size) const;
+
+		std::string m_directory;
+		std::vector<WatchedFile> m_files;
+		unsigned m_pollInterval;
+		int m_inotifyFd;
+
+		std::mutex m_mutex;
+		std::condition_variable m_stopCv;
+		bool m_stop;
+		std::vector<std::string> m_changed;
+		std::thread m_thread;
+	};
+
+}
+
+#endif
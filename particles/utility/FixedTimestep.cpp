@@ -0,0 +1,28 @@
+#include "FixedTimestep.h"
+
+#include <algorithm>
+
+namespace fhl
+{
+
+	FixedTimestep::FixedTimestep(float _step, unsigned _maxSteps) :
+		m_step{_step},
+		m_maxSteps{std::max(_maxSteps, 1u)},
+		m_accumulator{0.f}
+	{
+	}
+
+	unsigned FixedTimestep::advance(float _frameTime)
+	{
+		m_accumulator += _frameTime;
+		const unsigned steps = unsigned(m_accumulator / m_step);
+		if (steps > m_maxSteps)
+		{
+			m_accumulator = 0.f;
+			return m_maxSteps;
+		}
+		m_accumulator = std::max(0.f, m_accumulator - steps * m_step);
+		return steps;
+	}
+
+}
@@ -0,0 +1,31 @@
+#ifndef FHL_UTILITY_FIXED_TIMESTEP_H
+#define FHL_UTILITY_FIXED_TIMESTEP_H
+
+namespace fhl
+{
+
+	/*
+	 * Accumulates frame time and converts it into a number of fixed steps.
+	 * At most `_maxSteps` are run per frame, time beyond that is dropped.
+	 */
+	class FixedTimestep
+	{
+	public:
+		FixedTimestep(float _step, unsigned _maxSteps);
+
+		/* returns number of steps to run for a frame that took _frameTime seconds */
+		unsigned advance(float _frameTime);
+
+		float getStep() const { return m_step; }
+		/* fraction of a step accumulated but not simulated yet, for interpolating between the last two states */
+		float getAlpha() const { return m_accumulator / m_step; }
+
+	private:
+		float m_step;
+		unsigned m_maxSteps;
+		float m_accumulator;
+	};
+
+}
+
+#endif
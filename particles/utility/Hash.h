@@ -0,0 +1,23 @@
+#ifndef FHL_UTILITY_HASH_H
+#define FHL_UTILITY_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fhl
+{
+
+	enum : std::uint64_t { Fnv1aOffset = 0xcbf29ce484222325ull, Fnv1aPrime = 0x100000001b3ull };
+
+	/* 64-bit FNV-1a, pass the previous result as _hash to hash several pieces as one */
+	inline std::uint64_t fnv1a(const void * _data, std::size_t _size, std::uint64_t _hash = Fnv1aOffset)
+	{
+		const unsigned char * bytes = static_cast<const unsigned char *>(_data);
+		for (std::size_t i = 0u; i < _size; ++i)
+			_hash = (_hash ^ bytes[i]) * Fnv1aPrime;
+		return _hash;
+	}
+
+}
+
+#endif
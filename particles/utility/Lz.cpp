@@ -0,0 +1,178 @@
+#include "Lz.h"
+
+#include <cstring>
+
+namespace fhl
+{
+	namespace lz
+	{
+		namespace
+		{
+			enum : std::size_t
+			{
+				MinMatch = 4u,
+				MaxOffset = 0xffffu,
+				HashLog = 14u,
+				LastLiterals = 8u // matches never reach the last bytes, keeps the match search in bounds
+			};
+
+			std::uint32_t read32(const std::uint8_t * _p)
+			{
+				std::uint32_t v;
+				std::memcpy(&v, _p, sizeof(v));
+				return v;
+			}
+
+			std::uint64_t read64(const std::uint8_t * _p)
+			{
+				std::uint64_t v;
+				std::memcpy(&v, _p, sizeof(v));
+				return v;
+			}
+
+			std::uint32_t hash(std::uint32_t _seq) { return (_seq * 2654435761u) >> (32u - HashLog); }
+
+			std::uint8_t * writeLength(std::uint8_t * _dst, std::size_t _len)
+			{
+				for (; _len >= 255u; _len -= 255u)
+					*_dst++ = 255u;
+				*_dst++ = std::uint8_t(_len);
+				return _dst;
+			}
+
+			std::uint8_t * writeSequence(std::uint8_t * _dst, const std::uint8_t * _literals, std::size_t _litLen, std::size_t _offset, std::size_t _matchLen)
+			{
+				const std::size_t matchCode = _matchLen ? _matchLen - MinMatch : 0u;
+				*_dst++ = std::uint8_t(((_litLen < 15u ? _litLen : 15u) << 4) | (matchCode < 15u ? matchCode : 15u));
+				if (_litLen >= 15u)
+					_dst = writeLength(_dst, _litLen - 15u);
+				if (_litLen)
+					std::memcpy(_dst, _literals, _litLen);
+				_dst += _litLen;
+				if (!_matchLen)
+					return _dst;
+				*_dst++ = std::uint8_t(_offset);
+				*_dst++ = std::uint8_t(_offset >> 8);
+				if (matchCode >= 15u)
+					_dst = writeLength(_dst, matchCode - 15u);
+				return _dst;
+			}
+
+			bool readLength(const std::uint8_t *& _src, const std::uint8_t * _end, std::size_t & _len)
+			{
+				std::uint8_t b;
+				do
+				{
+					if (_src == _end)
+						return false;
+					b = *_src++;
+					_len += b;
+				} while (b == 255u);
+				return true;
+			}
+		}
+
+		std::size_t compressBound(std::size_t _size)
+		{
+			return _size + _size / 255u + 16u;
+		}
+
+		std::size_t compress(const std::uint8_t * _src, std::size_t _size, std::uint8_t * _dst)
+		{
+			std::uint8_t * const dstBegin = _dst;
+			std::size_t anchor = 0u;
+			if (_size > LastLiterals + MinMatch)
+			{
+				static thread_local std::uint32_t table[1u << HashLog];
+				std::memset(table, 0, sizeof(table));
+
+				const std::size_t matchLimit = _size - LastLiterals;
+				std::size_t ip = 1u;
+				std::size_t misses = 0u;
+				while (ip + MinMatch <= matchLimit)
+				{
+					const std::uint32_t seq = read32(_src + ip);
+					const std::uint32_t h = hash(seq);
+					const std::size_t ref = table[h];
+					table[h] = std::uint32_t(ip);
+					if (ip - ref > MaxOffset || read32(_src + ref) != seq)
+					{
+						ip += 1u + (misses++ >> 6); // skip faster through incompressible data
+						continue;
+					}
+					misses = 0u;
+
+					std::size_t len = MinMatch;
+					while (ip + len + 8u <= matchLimit)
+					{
+						const std::uint64_t diff = read64(_src + ip + len) ^ read64(_src + ref + len);
+						if (diff)
+						{
+							std::size_t same = 0u;
+							while (!(diff >> (8u * same) & 0xffu))
+								++same;
+							len += same;
+							break;
+						}
+						len += 8u;
+					}
+					while (ip + len < matchLimit && _src[ip + len] == _src[ref + len])
+						++len;
+
+					_dst = writeSequence(_dst, _src + anchor, ip - anchor, ip - ref, len);
+					ip += len;
+					anchor = ip;
+					if (ip - 2u + MinMatch <= matchLimit)
+						table[hash(read32(_src + ip - 2u))] = std::uint32_t(ip - 2u);
+				}
+			}
+			_dst = writeSequence(_dst, _src + anchor, _size - anchor, 0u, 0u);
+			return std::size_t(_dst - dstBegin);
+		}
+
+		bool decompress(const std::uint8_t * _src, std::size_t _size, std::uint8_t * _dst, std::size_t _dstSize)
+		{
+			const std::uint8_t * const srcEnd = _src + _size;
+			std::size_t op = 0u;
+			while (_src < srcEnd)
+			{
+				const std::uint8_t token = *_src++;
+				std::size_t litLen = token >> 4;
+				if (litLen == 15u && !readLength(_src, srcEnd, litLen))
+					return false;
+				if (litLen > std::size_t(srcEnd - _src) || litLen > _dstSize - op)
+					return false;
+				if (litLen)
+					std::memcpy(_dst + op, _src, litLen);
+				_src += litLen;
+				op += litLen;
+				if (_src == srcEnd)
+					break; // last sequence has no match
+
+				if (srcEnd - _src < 2)
+					return false;
+				const std::size_t offset = std::size_t(_src[0]) | std::size_t(_src[1]) << 8;
+				_src += 2;
+				std::size_t matchLen = token & 0xfu;
+				if (matchLen == 15u && !readLength(_src, srcEnd, matchLen))
+					return false;
+				matchLen += MinMatch;
+				if (!offset || offset > op || matchLen > _dstSize - op)
+					return false;
+
+				std::uint8_t * const out = _dst + op;
+				const std::uint8_t * const ref = out - offset;
+				if (offset >= matchLen)
+					std::memcpy(out, ref, matchLen);
+				else if (offset == 1u)
+					std::memset(out, *ref, matchLen);
+				else
+					for (std::size_t i = 0u; i < matchLen; ++i)
+						out[i] = ref[i];
+				op += matchLen;
+			}
+			return op == _dstSize;
+		}
+	}
+
+}
@@ -0,0 +1,28 @@
+#ifndef FHL_UTILITY_LZ_H
+#define FHL_UTILITY_LZ_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fhl
+{
+
+	/*
+	 * Byte-oriented LZ77 block compression (LZ4-like sequences: token, literals, 16-bit offset, match length).
+	 * Favours speed over ratio; meant for long runs of repeated bytes such as XOR deltas.
+	 */
+	namespace lz
+	{
+		/* worst case compressed size of _size bytes */
+		std::size_t compressBound(std::size_t _size);
+
+		/* _dst must hold compressBound(_size) bytes; returns compressed size */
+		std::size_t compress(const std::uint8_t * _src, std::size_t _size, std::uint8_t * _dst);
+
+		/* returns false if _src is malformed or does not decompress to exactly _dstSize bytes */
+		bool decompress(const std::uint8_t * _src, std::size_t _size, std::uint8_t * _dst, std::size_t _dstSize);
+	}
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include "ThreadPool.h"
+#include "Trace.h"
+
+#include <algorithm>
+
+namespace fhl
+{
+
+	namespace
+	{
+		std::uint64_t packRange(std::uint64_t _front, std::uint64_t _back) { return (_front << 32) | _back; }
+		std::size_t rangeFront(std::uint64_t _range) { return std::size_t(_range >> 32); }
+		std::size_t rangeBack(std::uint64_t _range) { return std::size_t(_range & 0xffffffffu); }
+	}
+
+	ThreadPool::ThreadPool(unsigned _threadCount) :
+		m_threadCount{_threadCount ? _threadCount : std::max(1u, std::thread::hardware_concurrency())},
+		m_workers{new Worker[m_threadCount]},
+		m_generation{0u},
+		m_stop{false},
+		m_activeWorkers{0u},
+		m_func{nullptr},
+		m_count{0u},
+		m_grain{1u}
+	{
+		for (unsigned i = 0u; i < m_threadCount; ++i)
+			m_workers[i].range.store(0u, std::memory_order_relaxed);
+		resetStats();
+
+		m_threads.reserve(m_threadCount - 1u);
+		for (unsigned i = 1u; i < m_threadCount; ++i)
+			m_threads.emplace_back(&ThreadPool::workerMain, this, i);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_stop = true;
+		}
+		m_wakeCv.notify_all();
+		for (std::thread & t : m_threads)
+			t.join();
+	}
+
+	void ThreadPool::parallelFor(std::size_t _count, std::size_t _grain, const RangeFunc & _func)
+	{
+		if (!_count)
+			return;
+		_grain = std::max<std::size_t>(_grain, 1u);
+		const std::size_t chunkCount = (_count + _grain - 1u) / _grain;
+
+		m_func = &_func;
+		m_count = _count;
+		m_grain = _grain;
+
+		if (m_threadCount == 1u || chunkCount == 1u)
+		{
+			m_workers[0].range.store(packRange(0u, chunkCount), std::memory_order_relaxed);
+			runJob(0u);
+			return;
+		}
+
+		for (unsigned i = 0u; i < m_threadCount; ++i)
+		{
+			const std::size_t front = chunkCount * i / m_threadCount;
+			const std::size_t back = chunkCount * (i + 1u) / m_threadCount;
+			m_workers[i].range.store(packRange(front, back), std::memory_order_relaxed);
+		}
+		m_activeWorkers.store(m_threadCount, std::memory_order_release);
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			++m_generation;
+		}
+		m_wakeCv.notify_all();
+
+		runJob(0u);
+
+		std::unique_lock<std::mutex> lock{m_mutex};
+		m_activeWorkers.fetch_sub(1u, std::memory_order_acq_rel);
+		m_doneCv.wait(lock, [this] { return m_activeWorkers.load(std::memory_order_acquire) == 0u; });
+	}
+
+	std::vector<ThreadPool::WorkerStats> ThreadPool::getStats() const
+	{
+		std::vector<WorkerStats> stats;
+		stats.reserve(m_threadCount);
+		for (unsigned i = 0u; i < m_threadCount; ++i)
+			stats.push_back(m_workers[i].stats);
+		return stats;
+	}
+
+	void ThreadPool::resetStats()
+	{
+		for (unsigned i = 0u; i < m_threadCount; ++i)
+			m_workers[i].stats = WorkerStats{};
+	}
+
+	void ThreadPool::workerMain(unsigned _idx)
+	{
+		trace::setThreadName("pool worker");
+		std::uint64_t seenGeneration = 0u;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock{m_mutex};
+				m_wakeCv.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+				if (m_stop)
+					return;
+				seenGeneration = m_generation;
+			}
+
+			runJob(_idx);
+
+			if (m_activeWorkers.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+			{
+				std::lock_guard<std::mutex> lock{m_mutex};
+				m_doneCv.notify_one();
+			}
+		}
+	}
+
+	void ThreadPool::runJob(unsigned _idx)
+	{
+		trace::Scope scope{"parallelFor"};
+		Worker & self = m_workers[_idx];
+		++self.stats.jobs;
+		do
+		{
+			std::size_t chunk;
+			while (popFront(self, chunk))
+			{
+				executeChunk(chunk);
+				++self.stats.chunks;
+			}
+		} while (steal(_idx));
+	}
+
+	bool ThreadPool::popFront(Worker & _w, std::size_t & _chunk)
+	{
+		std::uint64_t range = _w.range.load(std::memory_order_acquire);
+		for (;;)
+		{
+			const std::size_t front = rangeFront(range), back = rangeBack(range);
+			if (front >= back)
+				return false;
+			if (_w.range.compare_exchange_weak(range, packRange(front + 1u, back), std::memory_order_acq_rel))
+			{
+				_chunk = front;
+				return true;
+			}
+		}
+	}
+
+	bool ThreadPool::steal(unsigned _thief)
+	{
+		Worker & thief = m_workers[_thief];
+		for (unsigned i = 1u; i < m_threadCount; ++i)
+		{
+			Worker & victim = m_workers[(_thief + i) % m_threadCount];
+			std::uint64_t range = victim.range.load(std::memory_order_acquire);
+			for (;;)
+			{
+				const std::size_t front = rangeFront(range), back = rangeBack(range);
+				if (front >= back)
+					break;
+				// take the back half, leaving the victim the chunks closest to what it is working on
+				const std::size_t mid = back - std::max<std::size_t>(1u, (back - front) / 2u);
+				if (victim.range.compare_exchange_weak(range, packRange(front, mid), std::memory_order_acq_rel))
+				{
+					// own range is empty, so nobody else can be modifying it
+					thief.range.store(packRange(mid, back), std::memory_order_release);
+					thief.stats.stolenChunks += back - mid;
+					++thief.stats.steals;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void ThreadPool::executeChunk(std::size_t _chunk)
+	{
+		const std::size_t begin = _chunk * m_grain;
+		(*m_func)(begin, std::min(begin + m_grain, m_count));
+	}
+
+}
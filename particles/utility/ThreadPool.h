@@ -0,0 +1,83 @@
+#ifndef FHL_UTILITY_THREAD_POOL_H
+#define FHL_UTILITY_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fhl
+{
+
+	/*
+	 * Fork-join pool for data-parallel loops. Every parallelFor() splits the index range into
+	 * chunks, hands each participant a contiguous run of them and lets participants that ran dry
+	 * steal half of the remaining chunks of another one. The calling thread is participant 0.
+	 * parallelFor() must not be called concurrently or from inside a job.
+	 */
+	class ThreadPool
+	{
+	public:
+		using RangeFunc = std::function<void(std::size_t, std::size_t)>;
+
+		struct WorkerStats
+		{
+			std::size_t jobs;         // parallelFor calls the worker took part in
+			std::size_t chunks;       // chunks executed
+			std::size_t stolenChunks; // chunks taken from other workers
+			std::size_t steals;       // successful steal operations
+		};
+
+		explicit ThreadPool(unsigned _threadCount = 0u); // 0 - use hardware concurrency
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool & operator=(const ThreadPool &) = delete;
+
+		unsigned getThreadCount() const { return m_threadCount; }
+
+		/* calls _func(begin, end) for the subranges of [0, _count) starting at multiples of _grain, _grain long but the last; blocks until all are done */
+		void parallelFor(std::size_t _count, std::size_t _grain, const RangeFunc & _func);
+
+		std::vector<WorkerStats> getStats() const;
+		void resetStats();
+
+	private:
+		struct Worker
+		{
+			std::atomic<std::uint64_t> range; // [front, back) chunk indices packed as (front << 32 | back)
+			WorkerStats stats;
+			char padding[64]; // keep workers' hot data on separate cache lines
+		};
+
+		void workerMain(unsigned _idx);
+		void runJob(unsigned _idx);
+		bool popFront(Worker & _w, std::size_t & _chunk);
+		bool steal(unsigned _thief);
+		void executeChunk(std::size_t _chunk);
+
+	private:
+		unsigned m_threadCount;
+		std::unique_ptr<Worker[]> m_workers;
+		std::vector<std::thread> m_threads;
+
+		std::mutex m_mutex;
+		std::condition_variable m_wakeCv;
+		std::condition_variable m_doneCv;
+		std::uint64_t m_generation;
+		bool m_stop;
+		std::atomic<unsigned> m_activeWorkers;
+
+		const RangeFunc * m_func;
+		std::size_t m_count;
+		std::size_t m_grain;
+	};
+
+}
+
+#endif
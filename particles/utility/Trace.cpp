@@ -0,0 +1,215 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fhl
+{
+
+	namespace trace
+	{
+
+		struct Event
+		{
+			const char * name;
+			std::uint64_t time;
+			std::uint64_t duration; // complete events only
+			char phase; // 'B'egin, 'E'nd or 'X' complete
+		};
+
+		/*
+		 * Events in a list of fixed-size chunks, appended by a single writer. The writer publishes the
+		 * event count with release order after filling an event (and linking a new chunk), so readers
+		 * that load it with acquire order can walk that many events without further synchronization.
+		 */
+		class Track
+		{
+		public:
+			explicit Track(unsigned _id, const char * _name) : m_id{_id}, m_name{_name}, m_head{new Chunk{}}, m_tail{m_head.get()}, m_count{0u} {}
+
+			void push(const Event & _event)
+			{
+				const std::size_t count = m_count.load(std::memory_order_relaxed);
+				const std::size_t slot = count % CHUNK_EVENTS;
+				if (count && !slot)
+				{
+					m_tail->next.reset(new Chunk{});
+					m_tail = m_tail->next.get();
+				}
+				m_tail->events[slot] = _event;
+				m_count.store(count + 1u, std::memory_order_release);
+			}
+
+			template<typename Func>
+			void forEach(Func _func) const
+			{
+				std::size_t remaining = m_count.load(std::memory_order_acquire);
+				const Chunk * chunk = m_head.get();
+				for (;;)
+				{
+					const std::size_t n = std::min<std::size_t>(remaining, CHUNK_EVENTS);
+					for (std::size_t i = 0u; i < n; ++i)
+						_func(chunk->events[i]);
+					remaining -= n;
+					if (!remaining)
+						break;
+					// only followed once the published count says the writer linked it
+					chunk = chunk->next.get();
+				}
+			}
+
+			unsigned getId() const { return m_id; }
+			const char * getName() const { return m_name.load(std::memory_order_acquire); }
+			void setName(const char * _name) { m_name.store(_name, std::memory_order_release); }
+
+		private:
+			enum { CHUNK_EVENTS = 4096 };
+
+			struct Chunk
+			{
+				Event events[CHUNK_EVENTS];
+				std::unique_ptr<Chunk> next;
+			};
+
+			unsigned m_id;
+			std::atomic<const char *> m_name;
+			std::unique_ptr<Chunk> m_head;
+			Chunk * m_tail; // writer only
+			std::atomic<std::size_t> m_count;
+		};
+
+		namespace
+		{
+			std::atomic<bool> enabled{false};
+
+			struct Registry
+			{
+				std::mutex mutex; // guards the list only, taken once per track
+				std::vector<std::unique_ptr<Track>> tracks;
+			};
+
+			Registry & registry()
+			{
+				static Registry instance;
+				return instance;
+			}
+
+			Track * addTrack(const char * _name)
+			{
+				Registry & reg = registry();
+				std::lock_guard<std::mutex> lock{reg.mutex};
+				reg.tracks.emplace_back(new Track{unsigned(reg.tracks.size() + 1u), _name});
+				return reg.tracks.back().get();
+			}
+
+			Track & threadTrack()
+			{
+				thread_local Track * track = addTrack(nullptr);
+				return *track;
+			}
+
+			void writeName(std::FILE * _file, const char * _name)
+			{ // names are identifiers or short phrases, only quotes and backslashes need escaping
+				for (; *_name; ++_name)
+				{
+					if (*_name == '"' || *_name == '\\')
+						std::fputc('\\', _file);
+					std::fputc(*_name, _file);
+				}
+			}
+		}
+
+		void enable()
+		{
+			now(); // fix the epoch
+			enabled.store(true, std::memory_order_relaxed);
+		}
+
+		bool isEnabled()
+		{
+			return enabled.load(std::memory_order_relaxed);
+		}
+
+		std::uint64_t now()
+		{
+			using Clock = std::chrono::steady_clock;
+			static const Clock::time_point epoch = Clock::now();
+			return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+		}
+
+		void setThreadName(const char * _name)
+		{
+			if (isEnabled())
+				threadTrack().setName(_name);
+		}
+
+		void begin(const char * _name)
+		{
+			threadTrack().push(Event{_name, now(), 0u, 'B'});
+		}
+
+		void end()
+		{
+			threadTrack().push(Event{nullptr, now(), 0u, 'E'});
+		}
+
+		Track * createTrack(const char * _name)
+		{
+			return addTrack(_name);
+		}
+
+		void complete(Track * _track, const char * _name, std::uint64_t _begin, std::uint64_t _duration)
+		{
+			_track->push(Event{_name, _begin, _duration, 'X'});
+		}
+
+		bool write(const char * _path)
+		{
+			std::FILE * file = std::fopen(_path, "w");
+			if (!file)
+			{
+				std::printf("Could not open %s for writing\n", _path);
+				return false;
+			}
+
+			Registry & reg = registry();
+			std::lock_guard<std::mutex> lock{reg.mutex};
+			std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+			bool first = true;
+			for (const std::unique_ptr<Track> & track : reg.tracks)
+			{
+				const unsigned tid = track->getId();
+				std::fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", tid);
+				if (const char * name = track->getName())
+					writeName(file, name);
+				else
+					std::fprintf(file, "thread %u", tid);
+				std::fprintf(file, "\"}}");
+				first = false;
+
+				track->forEach([&](const Event & _event) {
+					// timestamps are in microseconds
+					std::fprintf(file, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", _event.phase, tid, _event.time * 1e-3);
+					if (_event.phase == 'X')
+						std::fprintf(file, ",\"dur\":%.3f", _event.duration * 1e-3);
+					if (_event.name)
+					{
+						std::fprintf(file, ",\"name\":\"");
+						writeName(file, _event.name);
+						std::fputc('"', file);
+					}
+					std::fputc('}', file);
+				});
+			}
+			std::fprintf(file, "\n]}\n");
+			return std::fclose(file) == 0;
+		}
+
+	}
+
+}
@@ -0,0 +1,58 @@
+#ifndef FHL_UTILITY_TRACE_H
+#define FHL_UTILITY_TRACE_H
+
+#include <cstdint>
+
+namespace fhl
+{
+
+	/*
+	 * Timeline of scoped CPU events, exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+	 * Every thread appends to its own buffer without locks; the buffers live until exit so a thread's events
+	 * survive the thread, and write() may run at any time while other threads keep recording.
+	 * Event names are not copied and must outlive the trace (string literals).
+	 * Recording is off until enable() is called; a disabled Scope costs one relaxed load.
+	 */
+	namespace trace
+	{
+
+		class Track;
+
+		void enable();
+		bool isEnabled();
+
+		/* nanoseconds since the first call, on the clock all events are timestamped with */
+		std::uint64_t now();
+
+		/* names the calling thread in the exported trace, ignored before enable() */
+		void setThreadName(const char * _name);
+
+		void begin(const char * _name);
+		void end();
+
+		/* extra timeline not bound to a thread (e.g. GPU passes), must be written by one thread at a time */
+		Track * createTrack(const char * _name);
+		/* event on _track spanning [_begin, _begin + _duration), both in now() nanoseconds */
+		void complete(Track * _track, const char * _name, std::uint64_t _begin, std::uint64_t _duration);
+
+		/* writes events recorded so far; scopes still open appear as running until the end of the trace */
+		bool write(const char * _path);
+
+		class Scope
+		{
+		public:
+			explicit Scope(const char * _name) : m_active{isEnabled()} { if (m_active) begin(_name); }
+			~Scope() { if (m_active) end(); }
+
+			Scope(const Scope &) = delete;
+			Scope & operator=(const Scope &) = delete;
+
+		private:
+			bool m_active;
+		};
+
+	}
+
+}
+
+#endif
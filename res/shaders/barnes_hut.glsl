@@ -0,0 +1,36 @@
+// Barnes-Hut tree of the particles in use (see GlBarnesHut): a binary radix tree over the particles sorted by Morton code,
+// with the total mass, centre of mass and bounding box of every internal node. Leaves are the sorted particles themselves.
+// Prepended after morton.glsl.
+layout(std140, binding = 6) uniform GravityParams {
+	vec3 domainMin; // Morton codes quantize positions in the cube from domainMin, clamped outside it
+	float domainScale; // Morton grid cells per unit
+	float openingAngle2; // nodes smaller than openingAngle times their distance are not opened
+	uint leafCount;
+	uint gravityPadding[2];
+};
+const uint EMPTY_LEAF_KEY = 0xffffffffu; // key of particles not in the tree, sorted after all Morton codes
+const uint LEAF_BIT = 0x80000000u; // child references with it set are leaves
+layout(std430, binding = 15) restrict buffer TreeKeys {
+	uint leafKey[];
+};
+layout(std430, binding = 16) restrict buffer TreeParticles {
+	uint leafParticle[];
+};
+// internal node i, children in the w components
+struct TreeNode {
+	vec4 centerOfMass; // w - mass
+	vec4 boxMin; // w - left child bits
+	vec4 boxMax; // w - right child bits
+};
+layout(std430, binding = 21) restrict coherent buffer TreeNodes {
+	TreeNode nodes[];
+};
+// parent of internal node i at i, of leaf i at leafCount - 1 + i
+layout(std430, binding = 22) restrict buffer TreeParents {
+	uint parents[];
+};
+layout(std430, binding = 23) restrict coherent buffer TreeVisits {
+	uint visits[];
+};
+
+uint mortonOf(vec3 pos) { return mortonCode((pos - domainMin) * domainScale); }
@@ -0,0 +1,34 @@
+// Stream compaction of the particles in use (see GlParticleCompactor), prepended after state_access.glsl, particle_systems.glsl, lifetime.glsl and free_list.glsl
+layout(std140, binding = 4) uniform CompactParams {
+	vec3 killCenter;
+	float killRadius; // particles farther from killCenter are removed
+	uint moveWords; // 32-bit words per particle of the attribute moved by compact_move.comp
+	uint movePhase; // 0 - scatter survivors to the scratch buffer, 1 - copy the ranges in use back
+	uint mortonBits; // Morton code bits of the survivor order keys, below the system index
+	uint compactPadding;
+	vec3 mortonMin; // Morton codes quantize positions in the cube from mortonMin
+	float mortonScale; // Morton grid cells per unit
+};
+// survivors of the dispatch workgroups before each one, followed by the total
+layout(std430, binding = 11) restrict buffer GroupPrefix {
+	uint groupPrefix[];
+};
+// new index of every particle in use, DISCARDED for the removed ones
+layout(std430, binding = 12) restrict buffer Destinations {
+	uint destination[];
+};
+const uint DISCARDED = 0xffffffffu;
+// survivors sorted by system and then Morton code, when compaction also reorders (see GlParticleCompactor::setMortonOrder)
+layout(std430, binding = 15) restrict buffer OrderKeys {
+	uint orderKey[];
+};
+layout(std430, binding = 16) restrict buffer OrderParticles {
+	uint orderParticle[];
+};
+const uint UNORDERED_KEY = 0xffffffffu; // key of the particles not surviving, sorted last
+
+bool survives(uint system, uint idx) { return isLive(system, idx) && isAlive(idx) && distance(loadPosition(idx), killCenter) <= killRadius; }
+uint systemSurvivors(uint system) {
+	const uint groupBase = states[system].groupBase;
+	return groupPrefix[groupBase + (states[system].count + 63u) / 64u] - groupPrefix[groupBase];
+}
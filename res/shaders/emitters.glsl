@@ -0,0 +1,21 @@
+// Emitters of the current step and the spawn table written by emit_prepare.comp (see ParticleSpawner)
+struct Emitter {
+	vec3 position;
+	float speed;
+	float lifetime;
+	uint system;
+	uint requested; // particles to spawn this step
+	float padding;
+};
+layout(std140, binding = 3) uniform EmitterParams {
+	uint emitterCount;
+	uint seed;
+	Emitter emitters[MAX_EMITTERS];
+};
+layout(std430, binding = 10) restrict buffer Spawn {
+	uint emitGroupsX; // glDispatchComputeIndirect arguments of emit.comp
+	uint emitGroupsY;
+	uint emitGroupsZ;
+	uint spawnTotal;
+	uvec4 emitterSpawn[]; // first spawn of the emitter, spawned particles, its system's stack size before spawning
+};
@@ -0,0 +1,45 @@
+// Force primitives of the current step (see ForceField.h), prepended to simulate.comp
+const uint FIELD_POINT = 0u;
+const uint FIELD_VORTEX = 1u;
+const uint FIELD_WIND = 2u;
+const uint FIELD_TURBULENCE = 3u;
+struct ForceField {
+	vec3 position;
+	uint type;
+	vec3 direction;
+	float strength;
+	float radius;
+	float phase;
+};
+layout(std140, binding = 8) uniform ForceFieldParams {
+	uint forceFieldCount;
+	ForceField forceFields[MAX_FORCE_FIELDS];
+};
+
+float fieldFalloff(float dist, float radius) { return 1.f / (1.f + dist * dist / (radius * radius)); }
+
+// adds the acceleration of every field at pos times dt to vel, field by field as the CPU simulation
+vec3 applyForceFields(vec3 pos, vec3 vel, float dt) {
+	for (uint i = 0u; i < forceFieldCount; ++i) {
+		const ForceField field = forceFields[i];
+		const vec3 r = pos - field.position;
+		vec3 acc;
+		if (field.type == FIELD_POINT) {
+			const float dist = length(r);
+			acc = -r * (field.strength * fieldFalloff(dist, field.radius) / max(dist, FORCE_FIELD_MIN_DISTANCE));
+		}
+		else if (field.type == FIELD_VORTEX) {
+			const vec3 perp = r - field.direction * dot(r, field.direction);
+			const float dist = length(perp);
+			acc = cross(field.direction, perp) * (field.strength * fieldFalloff(dist, field.radius) / max(dist, FORCE_FIELD_MIN_DISTANCE));
+		}
+		else if (field.type == FIELD_WIND)
+			acc = field.direction * field.strength;
+		else {
+			const vec3 q = r / field.radius + field.phase;
+			acc = vec3(sin(q.y) * cos(q.z), sin(q.z) * cos(q.x), sin(q.x) * cos(q.y)) * field.strength;
+		}
+		vel += acc * dt;
+	}
+	return vel;
+}
@@ -0,0 +1,6 @@
+// Per-frame render parameters, prepended to the vertex and geometry shaders
+layout(std140, binding = 1) uniform FrameParams {
+	mat4 view;
+	mat4 projection;
+	float alpha; // blend factor between the previous and the current simulation step (INTERPOLATE)
+};
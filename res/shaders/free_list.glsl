@@ -0,0 +1,11 @@
+// Per-system stacks of dead particle indices (see ParticleSpawner), prepended after particle_systems.glsl; used if LIFETIME is defined
+#ifdef LIFETIME
+// the stack of a system is deadIdx[first, first + deadCount[system])
+layout(std430, binding = 8) restrict buffer DeadCounts {
+	uint deadCount[];
+};
+layout(std430, binding = 9) restrict buffer DeadIndices {
+	uint deadIdx[];
+};
+void freeParticle(uint system, uint idx) { deadIdx[systems[system].first + atomicAdd(deadCount[system], 1u)] = idx; }
+#endif
@@ -0,0 +1,10 @@
+// Remaining particle lifetimes (see ParticleSpawner), used if LIFETIME is defined
+#ifdef LIFETIME
+// seconds, dead at or below 0, infinite for particles of systems without emitters
+layout(std430, binding = 7) restrict buffer Life {
+	float life[];
+};
+bool isAlive(uint idx) { return life[idx] > 0.f; }
+#else
+bool isAlive(uint idx) { return true; }
+#endif
@@ -0,0 +1,13 @@
+// Morton (Z-order) codes of cells of a 1024^3 grid, 10 bits per axis interleaved with x in the lowest bit (see Morton.h)
+uint expandMortonBits(uint v) {
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return v;
+}
+// cell coordinates are clamped to the grid, NaN goes to cell 0
+uint mortonCode(vec3 cell) {
+	const uvec3 q = uvec3(mix(vec3(0.f), min(cell, vec3(1023.f)), greaterThanEqual(cell, vec3(0.f))));
+	return expandMortonBits(q.x) | (expandMortonBits(q.y) << 1) | (expandMortonBits(q.z) << 2);
+}
@@ -0,0 +1,8 @@
+in vec3 fs_color;
+in vec2 fs_txCoords;
+out vec4 color;
+layout(binding = 0) uniform sampler2D txSampler;
+
+void main() {
+	color = texture(txSampler, fs_txCoords) * vec4(fs_color, 1.f);
+}
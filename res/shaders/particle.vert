@@ -0,0 +1,32 @@
+out vec3 vs_color;
+const vec3 LO_COLOR = vec3(0xb3, 0xd9, 0xff)/255.f, HI_COLOR = vec3(0xff, 0, 0x66)/255.f;
+
+#ifdef CULLING
+void main() {
+	const uint idx = particleIndex(uint(gl_VertexID));
+	vs_color = mix(LO_COLOR, HI_COLOR, smoothstep(0.f, COLOR_MAX_SPEED, length(loadVelocity(idx))));
+	gl_Position = view * vec4(renderPosition(idx), 1.f);
+}
+#else
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec4 velocity;
+#ifdef INTERPOLATE
+layout(location = 2) in vec4 prevPosition;
+#endif
+#ifdef LIFETIME
+layout(location = 3) in float life;
+out float vs_life; // dead particles are dropped by particle.geom
+#endif
+
+void main() {
+#ifdef LIFETIME
+	vs_life = life;
+#endif
+	vs_color = mix(LO_COLOR, HI_COLOR, smoothstep(0.f, COLOR_MAX_SPEED, length(velocity.xyz)));
+#ifdef INTERPOLATE
+	gl_Position = view * vec4(mix(prevPosition.xyz, position.xyz, alpha), 1.f);
+#else
+	gl_Position = view * vec4(position.xyz, 1.f);
+#endif
+}
+#endif
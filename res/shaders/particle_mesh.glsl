@@ -0,0 +1,36 @@
+// Particle-mesh gravity grid (see GlParticleMesh): PM_GRID^3 cells covering the cube from domainMin, periodic along every axis.
+// Mass is deposited cloud-in-cell in PM_MASS_SCALE fixed point, since there are no float atomics; the field holds the
+// density spectrum and then the potential, x + PM_GRID * (y + PM_GRID * z) ordered.
+const int PM_GRID = 1 << PM_GRID_BITS;
+layout(std140, binding = 7) uniform ParticleMeshParams {
+	vec3 domainMin;
+	float cellsPerUnit;
+	uint fftAxis; // line direction of pm_fft.comp
+	float fftSign; // -1 forward, 1 inverse (unnormalized)
+	uint meshPadding[2];
+};
+layout(std430, binding = 24) restrict buffer MeshDensity {
+	uint density[];
+};
+layout(std430, binding = 25) restrict buffer MeshField {
+	vec2 field[];
+};
+
+uint gridIndex(ivec3 cell) {
+	const ivec3 wrapped = cell & (PM_GRID - 1);
+	return uint(wrapped.x + PM_GRID * (wrapped.y + PM_GRID * wrapped.z));
+}
+// lowest of the 8 grid points around pos and the offset from it in cells; false for far or non-finite positions
+bool cloudInCell(vec3 pos, out ivec3 base, out vec3 frac) {
+	const vec3 u = (pos - domainMin) * cellsPerUnit - .5f;
+	if (!all(lessThan(abs(u), vec3(1e9f))))
+		return false;
+	const vec3 lower = floor(u);
+	base = ivec3(lower);
+	frac = u - lower;
+	return true;
+}
+float cornerWeight(vec3 frac, ivec3 corner) {
+	const vec3 w = mix(1.f - frac, frac, bvec3(corner));
+	return w.x * w.y * w.z;
+}
@@ -0,0 +1,22 @@
+// Alternative to particle.vert + particle.geom: expands each particle to 2 triangles (6 vertices) pulled from the state buffers by gl_VertexID
+out vec3 fs_color;
+out vec2 fs_txCoords;
+const vec3 LO_COLOR = vec3(0xb3, 0xd9, 0xff)/255.f, HI_COLOR = vec3(0xff, 0, 0x66)/255.f;
+const vec2 offsets[6] = {
+	vec2(0.f, 0.f), vec2(1.f, 0.f), vec2(0.f, 1.f), vec2(0.f, 1.f), vec2(1.f, 0.f), vec2(1.f, 1.f) };
+
+void main() {
+	const uint idx = particleIndex(uint(gl_VertexID) / 6u);
+	const vec2 offset = offsets[uint(gl_VertexID) % 6u];
+#if defined(LIFETIME) && !defined(CULLING)
+	if (!isAlive(idx)) { // all 6 vertices outside the clip volume
+		gl_Position = vec4(2.f, 2.f, 2.f, 1.f);
+		return;
+	}
+#endif
+	fs_color = mix(LO_COLOR, HI_COLOR, smoothstep(0.f, COLOR_MAX_SPEED, length(loadVelocity(idx))));
+	fs_txCoords = offset;
+	vec4 pos = view * vec4(renderPosition(idx), 1.f);
+	pos.xy += .5f * (offset - vec2(0.5f));
+	gl_Position = projection * pos;
+}
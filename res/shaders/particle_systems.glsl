@@ -0,0 +1,58 @@
+// Particle systems sharing the state buffers (see ParticleSystemManager), prepended to compute shaders.
+// Dispatches over particles are indirect, with (count + 63) / 64 workgroups per system in system order.
+struct ParticleSystem {
+	uint first;
+	uint capacity;
+	float attractorScale;
+	uint padding;
+};
+layout(std430, binding = 5) restrict readonly buffer Systems {
+	ParticleSystem systems[];
+};
+// glMultiDrawArraysIndirect command of a system, followed by its particle count and first workgroup
+struct SystemState {
+	uint drawCount;
+	uint instanceCount;
+	uint drawFirst;
+	uint baseInstance;
+	uint count; // particles in use from first, dead ones among them are only removed by compaction
+	uint groupBase;
+	uint padding[2];
+};
+layout(std430, binding = 6) restrict buffer SystemStates {
+	uint groupsX; // glDispatchComputeIndirect arguments covering all systems
+	uint groupsY;
+	uint groupsZ;
+	uint systemCount;
+	uint verticesPerParticle;
+	uint headerPadding[3];
+	SystemState states[];
+};
+
+// last system whose workgroups start at or before this one
+uint workgroupSystemIndex() {
+	uint lo = 0u, hi = systemCount - 1u;
+	while (lo < hi) {
+		const uint mid = (lo + hi + 1u) / 2u;
+		if (states[mid].groupBase <= gl_WorkGroupID.x)
+			lo = mid;
+		else
+			hi = mid - 1u;
+	}
+	return lo;
+}
+uint workgroupParticleIndex(uint system) { return systems[system].first + (gl_WorkGroupID.x - states[system].groupBase) * 64u + gl_LocalInvocationID.x; }
+bool isLive(uint system, uint idx) { return idx - systems[system].first < states[system].count; }
+
+// rebuilds draw commands and dispatch arguments after counts changed, run by a single invocation
+void updateSystemStates() {
+	uint groups = 0u;
+	for (uint i = 0u; i < systemCount; ++i) {
+		const uint count = states[i].count;
+		states[i].drawCount = count * verticesPerParticle;
+		states[i].drawFirst = systems[i].first * verticesPerParticle;
+		states[i].groupBase = groups;
+		groups += (count + 63u) / 64u;
+	}
+	groupsX = groups;
+}
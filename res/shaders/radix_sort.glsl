@@ -0,0 +1,28 @@
+// Stable LSD radix sort of key/value pairs, 4 bits per pass (see GlRadixSort), prepended to radix_*.comp
+// Every workgroup sorts a tile of RADIX_TILE consecutive elements, RADIX_ITEMS per invocation
+#define RADIX_ITEMS 8u
+#define RADIX_TILE (256u * RADIX_ITEMS)
+layout(std140, binding = 5) uniform RadixParams {
+	uint sortCount;
+	uint shift; // of the digit sorted by this pass
+	uint tileCount;
+	uint padding;
+};
+layout(std430, binding = 15) restrict readonly buffer SortKeysIn {
+	uint keysIn[];
+};
+layout(std430, binding = 16) restrict readonly buffer SortValuesIn {
+	uint valuesIn[];
+};
+layout(std430, binding = 17) restrict writeonly buffer SortKeysOut {
+	uint keysOut[];
+};
+layout(std430, binding = 18) restrict writeonly buffer SortValuesOut {
+	uint valuesOut[];
+};
+// elements of every digit per tile, digit-major so that the exclusive prefix sum gives the tiles' first destinations
+layout(std430, binding = 19) restrict buffer SortTileCounts {
+	uint tileCounts[];
+};
+
+uint digitOf(uint key) { return (key >> shift) & 15u; }
@@ -0,0 +1,6 @@
+// Drawn position of a particle, blended between the last two simulation steps if INTERPOLATE is defined
+#ifdef INTERPOLATE
+vec3 renderPosition(uint idx) { return mix(loadPrevPosition(idx), loadPosition(idx), alpha); }
+#else
+vec3 renderPosition(uint idx) { return loadPosition(idx); }
+#endif
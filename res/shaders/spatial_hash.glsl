@@ -0,0 +1,25 @@
+// Uniform grid of INTERACTION_RADIUS cells hashed by wrapping every 2^HASH_CELL_BITS cells (see GlSpatialHash);
+// neighbouring cells never share a key, particles of far cells sharing one are told apart by distance
+const uint HASH_CELL_MASK = (1u << HASH_CELL_BITS) - 1u;
+const uint HASH_EMPTY_KEY = 1u << (3 * HASH_CELL_BITS); // sorted after all cells, for particles not in the grid
+// cell keys and particle indices, sorted by key after the build
+layout(std430, binding = 15) restrict buffer HashKeys {
+	uint cellKey[];
+};
+layout(std430, binding = 16) restrict buffer HashParticles {
+	uint cellParticle[];
+};
+// [begin, end) of every key in the sorted particles, empty cells are (0, 0)
+layout(std430, binding = 20) restrict buffer HashCells {
+	uvec2 cellRange[];
+};
+
+// clamped so that far or non-finite positions still give a cell
+ivec3 cellOf(vec3 pos) {
+	const vec3 cell = floor(pos / INTERACTION_RADIUS);
+	return ivec3(mix(vec3(-1e9f), min(cell, vec3(1e9f)), greaterThanEqual(cell, vec3(-1e9f))));
+}
+uint keyOf(ivec3 cell) {
+	const uvec3 wrapped = uvec3(cell) & HASH_CELL_MASK;
+	return wrapped.x | (wrapped.y << HASH_CELL_BITS) | (wrapped.z << (2 * HASH_CELL_BITS));
+}
@@ -0,0 +1,46 @@
+// Position/velocity buffer access for the layouts in StateLayout.h
+#ifdef COMPACT_STATE
+layout(std430, binding = 0) restrict buffer Pos {
+	float position[];
+};
+layout(std430, binding = 1) restrict buffer Vel {
+	uvec2 velocity[];
+};
+vec3 loadPosition(uint idx) { return vec3(position[3 * idx], position[3 * idx + 1], position[3 * idx + 2]); }
+vec3 loadVelocity(uint idx) { return vec3(unpackHalf2x16(velocity[idx].x), unpackHalf2x16(velocity[idx].y).x); }
+void storePosition(uint idx, vec3 pos) {
+	position[3 * idx] = pos.x;
+	position[3 * idx + 1] = pos.y;
+	position[3 * idx + 2] = pos.z;
+}
+void storeVelocity(uint idx, vec3 vel) { velocity[idx] = uvec2(packHalf2x16(vel.xy), packHalf2x16(vec2(vel.z, 0.f))); }
+#ifdef INTERPOLATE
+layout(std430, binding = 4) restrict buffer PrevPos {
+	float prevPosition[];
+};
+vec3 loadPrevPosition(uint idx) { return vec3(prevPosition[3 * idx], prevPosition[3 * idx + 1], prevPosition[3 * idx + 2]); }
+void storePrevPosition(uint idx, vec3 pos) {
+	prevPosition[3 * idx] = pos.x;
+	prevPosition[3 * idx + 1] = pos.y;
+	prevPosition[3 * idx + 2] = pos.z;
+}
+#endif
+#else
+layout(std140, binding = 0) restrict buffer Pos {
+	vec4 position[];
+};
+layout(std140, binding = 1) restrict buffer Vel {
+	vec4 velocity[];
+};
+vec3 loadPosition(uint idx) { return position[idx].xyz; }
+vec3 loadVelocity(uint idx) { return velocity[idx].xyz; }
+void storePosition(uint idx, vec3 pos) { position[idx] = vec4(pos, 1.f); }
+void storeVelocity(uint idx, vec3 vel) { velocity[idx] = vec4(vel, 0.f); }
+#ifdef INTERPOLATE
+layout(std140, binding = 4) restrict buffer PrevPos {
+	vec4 prevPosition[];
+};
+vec3 loadPrevPosition(uint idx) { return prevPosition[idx].xyz; }
+void storePrevPosition(uint idx, vec3 pos) { prevPosition[idx] = vec4(pos, 1.f); }
+#endif
+#endif
@@ -0,0 +1,9 @@
+// Maps draw-relative particle index to particle index, through the list written by cull.comp if CULLING is defined
+#ifdef CULLING
+layout(std430, binding = 3) restrict readonly buffer Visible {
+	uint visibleIdx[];
+};
+uint particleIndex(uint i) { return visibleIdx[i]; }
+#else
+uint particleIndex(uint i) { return i; }
+#endif